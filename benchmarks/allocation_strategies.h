@@ -0,0 +1,224 @@
+#pragma once
+
+/**
+ * @file allocation_strategies.h
+ * @brief Compile-time allocation strategies for the parameterized benchmarks
+ * @details A strategy is a type with static `allocate<T>(args...)` and `deallocate(T*)`
+ * functions. Benchmarks take the strategy as a template parameter, so every allocator is
+ * measured through fully inlined code paths instead of an indirect call. Adding an
+ * allocator to the comparison only needs a new strategy type. A strategy whose capacity is
+ * fixed, so that allocate() can return nullptr, declares `static constexpr bool bounded =
+ * true`.
+ * @ingroup benchmarks
+ */
+
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "../src/LockFreeMemoryPool.h"
+#include "baseline_pools.h"
+#include "benchmark_common.h"
+
+#ifdef LFMP_BENCH_HAVE_BOOST_POOL
+#include <boost/pool/object_pool.hpp>
+#endif
+
+namespace bench {
+
+/**
+ * @brief Plain new/delete
+ * @ingroup benchmarks
+ */
+struct HeapStrategy {
+    template <typename T, typename... Args>
+    static T* allocate(Args&&... args) {
+        return new T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static void deallocate(T* obj) noexcept {
+        delete obj;
+    }
+};
+
+/**
+ * @brief Global registry pool (lockfree_pool_alloc_fast / lockfree_pool_free_fast)
+ * @details T must be registered with DEFINE_LOCKFREE_POOL in the benchmark program.
+ * @ingroup benchmarks
+ */
+struct PoolFastStrategy {
+    static constexpr bool bounded = true;
+
+    template <typename T, typename... Args>
+    static T* allocate(Args&&... args) {
+        return lfmemorypool::lockfree_pool_alloc_fast<T>(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static void deallocate(T* obj) noexcept {
+        lfmemorypool::lockfree_pool_free_fast(obj);
+    }
+};
+
+/**
+ * @brief One shared lock-based baseline pool per object type
+ * @tparam Pool Pool template from baseline_pools.h
+ * @tparam Capacity Slots per object type
+ * @ingroup benchmarks
+ */
+template <template <typename> class Pool, std::size_t Capacity>
+struct BaselinePoolStrategy {
+    static constexpr bool bounded = true;
+
+    template <typename T>
+    static inline Pool<T> pool{Capacity};
+
+    template <typename T, typename... Args>
+    static T* allocate(Args&&... args) {
+        return pool<T>.allocate(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static void deallocate(T* obj) noexcept {
+        pool<T>.deallocate(obj);
+    }
+};
+
+template <std::size_t Capacity>
+using MutexPoolStrategy = BaselinePoolStrategy<MutexFreeListPool, Capacity>;
+
+template <std::size_t Capacity>
+using SpinlockPoolStrategy = BaselinePoolStrategy<SpinlockFreeListPool, Capacity>;
+
+/// Whether Strategy has a fixed capacity (declares `bounded = true`); false otherwise
+template <typename Strategy, typename = void>
+inline constexpr bool is_bounded_strategy_v = false;
+
+template <typename Strategy>
+inline constexpr bool is_bounded_strategy_v<Strategy, std::void_t<decltype(Strategy::bounded)>> =
+    Strategy::bounded;
+
+namespace detail {
+// Construct a T in storage from a memory resource, returning the storage on failure
+template <typename T, typename... Args>
+T* construct_from(std::pmr::memory_resource& resource, Args&&... args) {
+    void* storage = resource.allocate(sizeof(T), alignof(T));
+    try {
+        return new (storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+        resource.deallocate(storage, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+template <typename T>
+void destroy_in(std::pmr::memory_resource& resource, T* obj) noexcept {
+    obj->~T();
+    resource.deallocate(obj, sizeof(T), alignof(T));
+}
+}  // namespace detail
+
+/**
+ * @brief One process-wide std::pmr::synchronized_pool_resource
+ * @ingroup benchmarks
+ */
+struct PmrSynchronizedStrategy {
+    static inline std::pmr::synchronized_pool_resource resource;
+
+    template <typename T, typename... Args>
+    static T* allocate(Args&&... args) {
+        return detail::construct_from<T>(resource, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static void deallocate(T* obj) noexcept {
+        detail::destroy_in(resource, obj);
+    }
+};
+
+/**
+ * @brief One std::pmr::unsynchronized_pool_resource per thread
+ * @details Objects must be freed on the thread that allocated them.
+ * @ingroup benchmarks
+ */
+struct PmrUnsynchronizedStrategy {
+    static inline thread_local std::pmr::unsynchronized_pool_resource resource;
+
+    template <typename T, typename... Args>
+    static T* allocate(Args&&... args) {
+        return detail::construct_from<T>(resource, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static void deallocate(T* obj) noexcept {
+        detail::destroy_in(resource, obj);
+    }
+};
+
+#ifdef LFMP_BENCH_HAVE_BOOST_POOL
+/**
+ * @brief One boost::object_pool<T> per thread and object type
+ * @details object_pool is not thread-safe and destroy() keeps its free list ordered,
+ * which makes frees O(n) in the number of free chunks.
+ * Objects must be freed on the thread that allocated them.
+ * @ingroup benchmarks
+ */
+struct BoostObjectPoolStrategy {
+    template <typename T>
+    static inline thread_local boost::object_pool<T> pool;
+
+    template <typename T, typename... Args>
+    static T* allocate(Args&&... args) {
+        T* storage = pool<T>.malloc();
+        if (!storage) {
+            return nullptr;
+        }
+        try {
+            return new (storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            pool<T>.free(storage);
+            throw;
+        }
+    }
+
+    template <typename T>
+    static void deallocate(T* obj) noexcept {
+        pool<T>.destroy(obj);
+    }
+};
+#endif
+
+/**
+ * @brief Routes another strategy through std::function for comparison
+ * @details Reproduces the type-erased dispatch the suite used before strategies became
+ * types, to show what the indirect call costs on top of each allocator. TestObject only.
+ * @ingroup benchmarks
+ */
+template <typename Inner>
+struct StdFunctionStrategy {
+    static constexpr bool bounded = is_bounded_strategy_v<Inner>;
+
+    static inline const std::function<TestObject*(int, double, const std::string&)> allocate_fn =
+        [](int id, double value, const std::string& name) {
+            return Inner::template allocate<TestObject>(id, value, name);
+        };
+    static inline const std::function<void(TestObject*)> deallocate_fn =
+        [](TestObject* obj) { Inner::deallocate(obj); };
+
+    template <typename T>
+    static T* allocate(int id, double value, const std::string& name) {
+        static_assert(std::is_same_v<T, TestObject>, "std::function strategies wrap TestObject");
+        return allocate_fn(id, value, name);
+    }
+
+    template <typename T>
+    static void deallocate(T* obj) {
+        deallocate_fn(obj);
+    }
+};
+
+}  // namespace bench
@@ -0,0 +1,115 @@
+#pragma once
+
+/**
+ * @file baseline_pools.h
+ * @brief Simple lock-based object pools used as baselines in the comparative benchmarks
+ * @details Both pools keep a fixed array of slots and an intrusive free list. They differ
+ * only in how the free list is protected: a std::mutex, or a test-and-test-and-set spinlock.
+ * They show what LockFreeMemoryPool gains (or loses) against the obvious locked designs.
+ * @ingroup benchmarks
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace bench {
+
+/// Minimal test-and-test-and-set spinlock (BasicLockable)
+class Spinlock {
+   public:
+    void lock() noexcept {
+        while (locked.exchange(true, std::memory_order_acquire)) {
+            while (locked.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() noexcept {
+        locked.store(false, std::memory_order_release);
+    }
+
+   private:
+    std::atomic<bool> locked{false};
+};
+
+/**
+ * @brief Fixed-capacity free-list pool guarded by a lock
+ * @tparam T Object type
+ * @tparam Lock BasicLockable protecting the free list
+ * @ingroup benchmarks
+ */
+template <typename T, typename Lock>
+class LockedFreeListPool {
+   public:
+    explicit LockedFreeListPool(std::size_t capacity) : slots(new Slot[capacity]) {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            slots[i].next = (i + 1 < capacity) ? &slots[i + 1] : nullptr;
+        }
+        free_list = capacity > 0 ? &slots[0] : nullptr;
+    }
+
+    /// Construct an object in a free slot, or return nullptr when the pool is exhausted
+    template <typename... Args>
+    T* allocate(Args&&... args) {
+        Slot* slot;
+        {
+            std::lock_guard<Lock> guard(lock);
+            slot = free_list;
+            if (!slot) {
+                return nullptr;
+            }
+            free_list = slot->next;
+        }
+
+        try {
+            return new (&slot->storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            release(slot);
+            throw;
+        }
+    }
+
+    void deallocate(T* obj) noexcept {
+        if (!obj) {
+            return;
+        }
+        obj->~T();
+        release(reinterpret_cast<Slot*>(obj));
+    }
+
+    LockedFreeListPool(const LockedFreeListPool&) = delete;
+    LockedFreeListPool& operator=(const LockedFreeListPool&) = delete;
+
+   private:
+    // Storage first so a T* converts back to its Slot*
+    union Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Slot* next;
+
+        Slot() : next(nullptr) {}
+    };
+
+    void release(Slot* slot) noexcept {
+        std::lock_guard<Lock> guard(lock);
+        slot->next = free_list;
+        free_list = slot;
+    }
+
+    std::unique_ptr<Slot[]> slots;
+    Slot* free_list = nullptr;
+    Lock lock;
+};
+
+template <typename T>
+using MutexFreeListPool = LockedFreeListPool<T, std::mutex>;
+
+template <typename T>
+using SpinlockFreeListPool = LockedFreeListPool<T, Spinlock>;
+
+}  // namespace bench
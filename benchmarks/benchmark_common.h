@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * @file benchmark_common.h
+ * @brief Types shared by the LockFreeMemoryPool benchmark programs
+ * @ingroup benchmarks
+ */
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "../src/LockFreeMemoryPool.h"
+
+/**
+ * @brief Test object for performance benchmarking
+ * @details Represents a realistic object with mixed data types and reasonable size
+ * for meaningful performance comparisons between heap and pool allocation.
+ * @ingroup benchmarks
+ */
+struct TestObject {
+    static constexpr size_t DATA_SIZE = 256;
+    static constexpr size_t NUMBERS_SIZE = 20;
+
+    int id;
+    double value;
+    char data[DATA_SIZE];
+    std::string name;
+    int numbers[NUMBERS_SIZE];
+
+    TestObject() : id(0), value(0.0), name("default") {
+    }
+
+    TestObject(int i, double v, const std::string& n)
+        : id(i), value(v), name(n) {
+    }
+
+    ~TestObject() = default;
+
+    // Method to prevent optimization from eliminating object usage
+    int do_work() const {
+        return id + static_cast<int>(value) + static_cast<int>(data[0]) + numbers[0];
+    }
+};
+
+/**
+ * @brief Fixed-size payload for object-size and footprint sweeps
+ * @details sizeof(Payload<N>) is N rounded up to 8 bytes, with 8-byte alignment like most
+ * real objects. The constructor writes every byte so the whole object counts as live memory.
+ * @ingroup benchmarks
+ */
+template <size_t N>
+struct alignas(8) Payload {
+    unsigned char bytes[N];
+
+    explicit Payload(int id = 0) {
+        std::memset(bytes, id & 0xff, N);
+    }
+
+    int do_work() const {
+        return bytes[0] + bytes[N - 1];
+    }
+};
+
+/// Slot type of LockFreeMemoryPool<T>: the object plus its availability flag, padded to the
+/// object's alignment. sizeof(SegmentOf<T>) is what the pool spends per object.
+template <typename T>
+using SegmentOf = typename std::remove_cvref_t<decltype(
+    std::declval<lfmemorypool::LockFreeMemoryPool<T>&>().get_segments_for_stats())>::value_type;
+
+/**
+ * @brief Match a `--name=value` command-line argument of the standalone benchmark programs
+ * @return true and the text after '=' in `value` when `arg` is option `name`
+ * @ingroup benchmarks
+ */
+inline bool parse_option(const char* arg, const char* name, std::string& value) {
+    const std::size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = arg + length + 1;
+    return true;
+}
+
+/**
+ * @brief Parse the whole of `text` as a number
+ * @return false, leaving `out` unspecified, when `text` is empty, has trailing characters or
+ * is out of range for T (a negative value for an unsigned T included)
+ * @ingroup benchmarks
+ */
+template <typename T>
+bool parse_number(const std::string& text, T& out) {
+    const char* const end = text.data() + text.size();
+    const auto [last, error] = std::from_chars(text.data(), end, out);
+    return !text.empty() && error == std::errc() && last == end;
+}
+
+/// xorshift64: cheap per-thread random stream for key and delay choices; `state` must be
+/// non-zero
+inline std::uint64_t next_random(std::uint64_t& state) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
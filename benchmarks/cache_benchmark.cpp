@@ -0,0 +1,165 @@
+/**
+ * @file cache_benchmark.cpp
+ * @brief ClockCache against an LRU list + std::unordered_map behind one std::mutex
+ * @details Threads replay a shared Zipfian (s = 0.99) trace over kKeySpace keys against one
+ * cache holding range(0) percent of them: a hit reads the value, a miss stores it, as a
+ * read-through cache does. Reports lookups per second and the hit rate.
+ *
+ * ClockCache marks hits with a reference bit under a per-shard shared lock and reuses
+ * evicted pool slots in place; the LRU baseline moves every hit to the front of its list
+ * under an exclusive lock and allocates list and map nodes for every miss.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../src/ClockCache.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kKeySpace = 1 << 18;
+constexpr std::size_t kTraceLength = 1 << 20;
+
+/// Cached value: large enough that copying it out is part of the cost
+struct Record {
+    std::uint64_t key = 0;
+    std::uint64_t payload[7] = {};
+};
+
+/// Strict LRU: std::list in recency order indexed by std::unordered_map, one std::mutex
+class LockedLruCache {
+   public:
+    explicit LockedLruCache(std::size_t capacity) : capacity_(capacity) {
+        index_.reserve(capacity);
+    }
+
+    bool get(std::uint64_t key, Record& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = index_.find(key);
+        if (it == index_.end()) {
+            return false;
+        }
+        order_.splice(order_.begin(), order_, it->second);
+        out = it->second->second;
+        return true;
+    }
+
+    void put(std::uint64_t key, const Record& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (const auto it = index_.find(key); it != index_.end()) {
+            it->second->second = value;
+            order_.splice(order_.begin(), order_, it->second);
+            return;
+        }
+        if (index_.size() == capacity_) {
+            index_.erase(order_.back().first);
+            order_.pop_back();
+        }
+        order_.emplace_front(key, value);
+        index_.emplace(key, order_.begin());
+    }
+
+   private:
+    std::mutex mutex_;
+    std::list<std::pair<std::uint64_t, Record>> order_;
+    std::unordered_map<std::uint64_t, std::list<std::pair<std::uint64_t, Record>>::iterator>
+        index_;
+    std::size_t capacity_;
+};
+
+using PooledClockCache = ClockCache<std::uint64_t, Record>;
+
+/// Zipfian key trace, drawn once and shared by every run; popular keys are scattered over
+/// the key space so they do not share a shard
+const std::vector<std::uint64_t>& zipf_trace() {
+    static const std::vector<std::uint64_t> trace = [] {
+        std::vector<double> cdf(kKeySpace);
+        double sum = 0.0;
+        for (std::size_t rank = 0; rank < kKeySpace; ++rank) {
+            sum += 1.0 / std::pow(static_cast<double>(rank + 1), 0.99);
+            cdf[rank] = sum;
+        }
+        std::mt19937_64 rng(42);
+        std::uniform_real_distribution<double> uniform(0.0, sum);
+        std::vector<std::uint64_t> keys(kTraceLength);
+        for (auto& key : keys) {
+            const auto rank = static_cast<std::uint64_t>(
+                std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin());
+            key = (rank * 0x9e3779b97f4a7c15ULL) % kKeySpace;
+        }
+        return keys;
+    }();
+    return trace;
+}
+
+template <typename Cache>
+std::unique_ptr<Cache>& shared_cache() {
+    static std::unique_ptr<Cache> cache;
+    return cache;
+}
+
+}  // namespace
+
+/**
+ * @brief Read-through lookups of a Zipfian trace against a cache of range(0)% of the keys
+ * @details Thread 0 creates the cache and warms it with one pass over the trace before the
+ * threads start; each thread replays the trace from its own offset.
+ * @ingroup benchmarks
+ */
+template <typename Cache>
+static void BM_CacheZipf(benchmark::State& state) {
+    const auto& trace = zipf_trace();
+    auto& cache = shared_cache<Cache>();
+    if (state.thread_index() == 0) {
+        const std::size_t capacity = kKeySpace * static_cast<std::size_t>(state.range(0)) / 100;
+        cache = std::make_unique<Cache>(capacity);
+        for (const std::uint64_t key : trace) {
+            Record record;
+            if (!cache->get(key, record)) {
+                cache->put(key, Record{key, {}});
+            }
+        }
+    }
+
+    std::size_t position = static_cast<std::size_t>(state.thread_index()) * 7919;
+    std::int64_t hits = 0;
+    for (auto _ : state) {
+        const std::uint64_t key = trace[position++ % kTraceLength];
+        Record record;
+        if (cache->get(key, record)) {
+            ++hits;
+            benchmark::DoNotOptimize(record);
+        } else {
+            cache->put(key, Record{key, {}});
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_rate"] = benchmark::Counter(
+        static_cast<double>(hits) / static_cast<double>(state.iterations()),
+        benchmark::Counter::kAvgThreads);
+    if (state.thread_index() == 0) {
+        cache.reset();
+    }
+}
+
+static void CacheShapes(benchmark::internal::Benchmark* b) {
+    b->ArgName("capacity_pct")->Arg(1)->Arg(10)->ThreadRange(1, 16)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_CacheZipf, PooledClockCache)->Apply(CacheShapes);
+BENCHMARK_TEMPLATE(BM_CacheZipf, LockedLruCache)->Apply(CacheShapes);
+
+BENCHMARK_MAIN();
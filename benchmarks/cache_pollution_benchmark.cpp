@@ -0,0 +1,156 @@
+/**
+ * @file cache_pollution_benchmark.cpp
+ * @brief How much allocator traffic slows down surrounding cache-resident work
+ * @details An allocator can look fast in isolation while evicting the application's working
+ * set. Each benchmark pass runs a fixed compute kernel (a dependent pointer chase over a
+ * working set sized to fit in L1 or L2), then replaces a number of random objects in a live
+ * set through the allocation strategy. Only the kernel is timed (manual time), so the
+ * result is the kernel's own speed with the allocator's cache and TLB footprint in between:
+ * for the pool that includes the slots its search scans, for malloc its metadata.
+ *
+ * Every run first times the kernel without any allocator work to get its own baseline, and
+ * reports `slowdown_pct` against it.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "allocation_strategies.h"
+#include "benchmark_common.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+using Object = Payload<64>;
+
+constexpr std::size_t kCacheLine = 64;
+constexpr std::size_t kPoolCapacity = 1 << 14;
+constexpr std::size_t kLiveObjects = kPoolCapacity / 2;  // Pool stays half full
+constexpr int kBaselinePasses = 64;
+
+/// Cache-line sized node of the kernel's pointer chase
+struct alignas(kCacheLine) ChaseNode {
+    ChaseNode* next;
+    std::uint64_t value;
+};
+
+/// Dependent walk over a random cycle through `bytes` of cache lines
+class ChaseKernel {
+   public:
+    explicit ChaseKernel(std::size_t bytes)
+        : nodes_(std::max<std::size_t>(bytes / kCacheLine, 2)) {
+        std::vector<std::size_t> order(nodes_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin() + 1, order.end(), std::mt19937(7));
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            nodes_[order[i]].next = &nodes_[order[(i + 1) % order.size()]];
+            nodes_[order[i]].value = i;
+        }
+    }
+
+    /// One full lap; returns the elapsed nanoseconds
+    double run() {
+        const auto start = std::chrono::steady_clock::now();
+        const ChaseNode* node = &nodes_[0];
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            sum += node->value;
+            node = node->next;
+        }
+        benchmark::DoNotOptimize(sum);
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count();
+    }
+
+   private:
+    std::vector<ChaseNode> nodes_;
+};
+
+/// Kernel only: the reference the allocator runs are compared with
+struct NoAllocation {};
+
+}  // namespace
+
+DEFINE_LOCKFREE_POOL(Object, kPoolCapacity);
+
+/**
+ * @brief Kernel over range(0) KB interleaved with range(1) object replacements per pass
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+static void BM_CachePollution(benchmark::State& state) {
+    constexpr bool allocates = !std::is_same_v<Strategy, NoAllocation>;
+    const auto working_set = static_cast<std::size_t>(state.range(0)) * 1024;
+    const auto replacements = static_cast<std::size_t>(state.range(1));
+
+    ChaseKernel kernel(working_set);
+
+    // Scattered live set, so the pool's free slots are spread out as in a long-running process
+    std::vector<Object*> live;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> slot_dist(0, kLiveObjects - 1);
+    if constexpr (allocates) {
+        std::vector<Object*> all(kPoolCapacity);
+        for (std::size_t i = 0; i < kPoolCapacity; ++i) {
+            all[i] = Strategy::template allocate<Object>(static_cast<int>(i));
+        }
+        std::shuffle(all.begin(), all.end(), rng);
+        for (std::size_t i = kLiveObjects; i < kPoolCapacity; ++i) {
+            Strategy::deallocate(all[i]);
+        }
+        all.resize(kLiveObjects);
+        live = std::move(all);
+    }
+
+    double baseline_ns = 0.0;
+    kernel.run();  // Warm the working set
+    for (int i = 0; i < kBaselinePasses; ++i) {
+        baseline_ns += kernel.run();
+    }
+    baseline_ns /= kBaselinePasses;
+
+    double kernel_ns = 0.0;
+    for (auto _ : state) {
+        if constexpr (allocates) {
+            for (std::size_t i = 0; i < replacements; ++i) {
+                Object*& victim = live[slot_dist(rng)];
+                Strategy::deallocate(victim);
+                victim = Strategy::template allocate<Object>(static_cast<int>(i));
+            }
+        }
+        const double pass_ns = kernel.run();
+        kernel_ns += pass_ns;
+        state.SetIterationTime(pass_ns * 1e-9);
+    }
+
+    if constexpr (allocates) {
+        for (Object* obj : live) {
+            Strategy::deallocate(obj);
+        }
+    }
+
+    const double mean_ns = kernel_ns / static_cast<double>(state.iterations());
+    state.counters["kernel_ns"] = mean_ns;
+    state.counters["baseline_kernel_ns"] = baseline_ns;
+    state.counters["slowdown_pct"] = (mean_ns / baseline_ns - 1.0) * 100.0;
+}
+
+static void PollutionArgs(benchmark::internal::Benchmark* b) {
+    b->ArgsProduct({{32, 256, 1024}, {16, 256}})->ArgNames({"kernel_kb", "replacements"});
+    b->UseManualTime()->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_TEMPLATE(BM_CachePollution, NoAllocation)->Apply(PollutionArgs);
+BENCHMARK_TEMPLATE(BM_CachePollution, bench::PoolFastStrategy)->Apply(PollutionArgs);
+BENCHMARK_TEMPLATE(BM_CachePollution, bench::HeapStrategy)->Apply(PollutionArgs);
+
+BENCHMARK_MAIN();
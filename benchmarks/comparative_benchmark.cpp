@@ -0,0 +1,61 @@
+/**
+ * @file comparative_benchmark.cpp
+ * @brief LockFreeMemoryPool against other allocators and baseline pools
+ * @details Runs the shared strategy workloads (strategy_workloads.h) for:
+ * - LockFreeMemoryPool (global registry, fast API)
+ * - new/delete with the process malloc
+ * - a std::mutex free-list pool and a spinlock free-list pool (baseline_pools.h)
+ * - std::pmr synchronized and unsynchronized (per-thread) pool resources
+ * - boost::object_pool (per thread), when Boost was found at configure time
+ *
+ * Replacement mallocs (jemalloc, tcmalloc, mimalloc) interpose malloc for the whole
+ * process, so CMake builds this file once more per allocator it finds, linked against that
+ * allocator and with BENCH_MALLOC_NAME set. Those builds only register Heap_<name>
+ * and the pool, so each allocator is compared in its own process.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <string>
+#include "../src/LockFreeMemoryPool.h"
+#include "allocation_strategies.h"
+#include "benchmark_common.h"
+#include "strategy_workloads.h"
+
+using namespace lfmemorypool;
+
+namespace {
+constexpr std::size_t kPoolCapacity = 100000;
+}
+
+DEFINE_LOCKFREE_POOL(TestObject, kPoolCapacity);
+
+using bench::RegisterStrategyBenchmarks;
+
+static void RegisterComparativeBenchmarks() {
+#ifdef BENCH_MALLOC_NAME
+    RegisterStrategyBenchmarks<bench::HeapStrategy>(std::string("Heap_") + BENCH_MALLOC_NAME);
+    RegisterStrategyBenchmarks<bench::PoolFastStrategy>("PoolFast");
+#else
+    RegisterStrategyBenchmarks<bench::HeapStrategy>("Heap_system");
+    RegisterStrategyBenchmarks<bench::PoolFastStrategy>("PoolFast");
+    RegisterStrategyBenchmarks<bench::MutexPoolStrategy<kPoolCapacity>>("MutexPool");
+    RegisterStrategyBenchmarks<bench::SpinlockPoolStrategy<kPoolCapacity>>("SpinlockPool");
+    RegisterStrategyBenchmarks<bench::PmrSynchronizedStrategy>("PmrSynchronized");
+    RegisterStrategyBenchmarks<bench::PmrUnsynchronizedStrategy>("PmrUnsynchronized");
+#ifdef LFMP_BENCH_HAVE_BOOST_POOL
+    // Ordered frees are O(n): keep object counts small enough to finish
+    RegisterStrategyBenchmarks<bench::BoostObjectPoolStrategy>("BoostObjectPool",
+                                                               {.max_objects = 10000});
+#endif
+#endif
+}
+
+int main(int argc, char** argv) {
+    RegisterComparativeBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file container_benchmark.cpp
+ * @brief Standard container churn with pool-backed node allocation versus std::allocator
+ * @details Container nodes are how most code would actually use the pool. Each benchmark
+ * builds a container of range(0) elements, churns it (every element removed and replaced
+ * once, in the container's natural order or at random keys), and tears it down, once with
+ * std::allocator and once with bench::PoolNodeAllocator (pool_node_allocator.h). Every
+ * thread works on its own container; node pools are shared between threads.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "pool_node_allocator.h"
+
+namespace {
+
+/// Keys in random order, the same sequence for every allocator
+std::vector<int> random_keys(std::size_t count, unsigned seed) {
+    std::vector<int> keys(count);
+    std::mt19937 rng(seed);
+    for (int& key : keys) {
+        key = static_cast<int>(rng());
+    }
+    return keys;
+}
+
+void report_operations(benchmark::State& state, std::size_t elements) {
+    // Build, replace every element once, tear down
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(elements) * 3);
+}
+
+}  // namespace
+
+/**
+ * @brief std::list<int>: push_back N, then N times pop_front + push_back
+ * @ingroup benchmarks
+ */
+template <template <typename> class Alloc>
+static void BM_ListChurn(benchmark::State& state) {
+    const auto elements = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        std::list<int, Alloc<int>> list;
+        for (std::size_t i = 0; i < elements; ++i) {
+            list.push_back(static_cast<int>(i));
+        }
+        for (std::size_t i = 0; i < elements; ++i) {
+            list.pop_front();
+            list.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(list.back());
+    }
+    report_operations(state, elements);
+}
+
+/**
+ * @brief std::map<int, int>: insert N random keys, then erase each and insert a new one
+ * @ingroup benchmarks
+ */
+template <template <typename> class Alloc>
+static void BM_MapChurn(benchmark::State& state) {
+    using Map = std::map<int, int, std::less<int>, Alloc<std::pair<const int, int>>>;
+    const auto elements = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys(elements, 1 + state.thread_index());
+    const auto replacements = random_keys(elements, 1001 + state.thread_index());
+
+    for (auto _ : state) {
+        Map map;
+        for (int key : keys) {
+            map.emplace(key, key);
+        }
+        for (std::size_t i = 0; i < elements; ++i) {
+            map.erase(keys[i]);
+            map.emplace(replacements[i], 0);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    report_operations(state, elements);
+}
+
+/**
+ * @brief std::unordered_map<int, int>: same pattern as BM_MapChurn, without reserve()
+ * @details Bucket arrays of up to kMaxPooledArrayBytes also come from the pool.
+ * @ingroup benchmarks
+ */
+template <template <typename> class Alloc>
+static void BM_UnorderedMapChurn(benchmark::State& state) {
+    using Map = std::unordered_map<int, int, std::hash<int>, std::equal_to<int>,
+                                   Alloc<std::pair<const int, int>>>;
+    const auto elements = static_cast<std::size_t>(state.range(0));
+    const auto keys = random_keys(elements, 1 + state.thread_index());
+    const auto replacements = random_keys(elements, 1001 + state.thread_index());
+
+    for (auto _ : state) {
+        Map map;
+        for (int key : keys) {
+            map.emplace(key, key);
+        }
+        for (std::size_t i = 0; i < elements; ++i) {
+            map.erase(keys[i]);
+            map.emplace(replacements[i], 0);
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    report_operations(state, elements);
+}
+
+/**
+ * @brief std::deque<int>: push_back N, then N times pop_front + push_back (queue use)
+ * @details The deque allocates fixed-size chunks and a chunk map, both arrays: they come
+ * from the size-class pools.
+ * @ingroup benchmarks
+ */
+template <template <typename> class Alloc>
+static void BM_DequeChurn(benchmark::State& state) {
+    const auto elements = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        std::deque<int, Alloc<int>> deque;
+        for (std::size_t i = 0; i < elements; ++i) {
+            deque.push_back(static_cast<int>(i));
+        }
+        for (std::size_t i = 0; i < elements; ++i) {
+            deque.pop_front();
+            deque.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(deque.back());
+    }
+    report_operations(state, elements);
+}
+
+// Per-thread sizes stay under bench::kNodePoolCapacity / 8 so 8 threads never exhaust a pool
+static void ContainerArgs(benchmark::internal::Benchmark* b) {
+    b->Arg(1000)->Arg(10000)->Arg(50000)->ArgName("elements");
+    b->ThreadRange(1, 8)->UseRealTime()->Unit(benchmark::kMicrosecond);
+}
+
+#define CONTAINER_BENCHMARKS(Benchmark)                                           \
+    BENCHMARK_TEMPLATE(Benchmark, std::allocator)->Apply(ContainerArgs);          \
+    BENCHMARK_TEMPLATE(Benchmark, bench::PoolNodeAllocator)->Apply(ContainerArgs)
+
+CONTAINER_BENCHMARKS(BM_ListChurn);
+CONTAINER_BENCHMARKS(BM_MapChurn);
+CONTAINER_BENCHMARKS(BM_UnorderedMapChurn);
+CONTAINER_BENCHMARKS(BM_DequeChurn);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,185 @@
+/**
+ * @file cross_thread_benchmark.cpp
+ * @brief Producer/consumer benchmark: objects allocated on one thread, freed on another
+ * @details P producer threads allocate messages and hand them to C consumer threads over
+ * single-producer/single-consumer rings (one ring per producer/consumer pair); consumers
+ * free what they receive. Every slot flag written by a producer's allocation is therefore
+ * written again by a consumer on another core, which is the coherence pattern the
+ * same-thread benchmarks never exercise.
+ *
+ * Reports message throughput and sampled latencies of allocate, free and the whole
+ * allocate-to-free handoff, for the pool and for the other thread-safe strategies.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "allocation_strategies.h"
+#include "latency_samples.h"
+#include "spsc_ring.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kMessagesPerProducer = 1 << 14;
+constexpr std::size_t kRingCapacity = 256;
+constexpr std::size_t kSampleEvery = 16;  // Timestamp every 16th operation
+constexpr std::size_t kPoolCapacity = 1 << 14;  // Above 4x4 rings of kRingCapacity in flight
+
+/// Message handed from producer to consumer
+struct Message {
+    std::int64_t allocated_ns;
+    std::uint32_t producer;
+    std::uint32_t sequence;
+    unsigned char body[48];
+
+    Message(std::uint32_t producer_id, std::uint32_t seq)
+        : allocated_ns(0), producer(producer_id), sequence(seq), body{} {
+    }
+};
+
+/// Carries messages from one producer to one consumer
+using MessageRing = bench::SpscRing<Message*, kRingCapacity>;
+
+/// Per-thread results, merged after each iteration
+struct ThreadResults {
+    bench::LatencySamples alloc_ns;
+    bench::LatencySamples free_ns;
+    bench::LatencySamples handoff_ns;
+    std::uint64_t alloc_retries = 0;
+};
+
+}  // namespace
+
+DEFINE_LOCKFREE_POOL(Message, kPoolCapacity);
+
+/**
+ * @brief range(0) producers feeding range(1) consumers through SPSC rings
+ * @details Threads are created outside the timed region and released together; the
+ * iteration time runs from the release until every message has been freed. When the pool
+ * is momentarily exhausted a producer yields and retries (counted as alloc_retries).
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+static void BM_CrossThreadFree(benchmark::State& state) {
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto consumers = static_cast<std::size_t>(state.range(1));
+
+    ThreadResults totals;
+    for (auto _ : state) {
+        // rings[p * consumers + c] carries messages from producer p to consumer c
+        auto rings = std::make_unique<MessageRing[]>(producers * consumers);
+        std::vector<ThreadResults> results(producers + consumers);
+        std::atomic<bool> go{false};
+        std::atomic<std::size_t> producers_done{0};
+
+        std::vector<std::thread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                ThreadResults& local = results[p];
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (std::size_t i = 0; i < kMessagesPerProducer; ++i) {
+                    const bool sampled = i % kSampleEvery == 0;
+                    const std::int64_t start = sampled ? bench::now_ns() : 0;
+                    Message* msg = nullptr;
+                    while (!(msg = Strategy::template allocate<Message>(
+                                 static_cast<std::uint32_t>(p), static_cast<std::uint32_t>(i)))) {
+                        ++local.alloc_retries;
+                        std::this_thread::yield();
+                    }
+                    // Only sampled messages carry a timestamp; the rest stay at 0
+                    if (sampled) {
+                        msg->allocated_ns = bench::now_ns();
+                        local.alloc_ns.add(msg->allocated_ns - start);
+                    }
+                    MessageRing& ring = rings[p * consumers + i % consumers];
+                    while (!ring.try_push(msg)) {
+                        std::this_thread::yield();
+                    }
+                }
+                producers_done.fetch_add(1, std::memory_order_release);
+            });
+        }
+        for (std::size_t c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c] {
+                ThreadResults& local = results[producers + c];
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (;;) {
+                    // Read the flag before draining so nothing pushed before it is missed
+                    const bool last_pass =
+                        producers_done.load(std::memory_order_acquire) == producers;
+                    bool idle = true;
+                    for (std::size_t p = 0; p < producers; ++p) {
+                        Message* msg = nullptr;
+                        while (rings[p * consumers + c].try_pop(msg)) {
+                            idle = false;
+                            if (msg->allocated_ns == 0) {
+                                Strategy::deallocate(msg);
+                                continue;
+                            }
+                            const std::int64_t start = bench::now_ns();
+                            local.handoff_ns.add(start - msg->allocated_ns);
+                            Strategy::deallocate(msg);
+                            local.free_ns.add(bench::now_ns() - start);
+                        }
+                    }
+                    if (last_pass && idle) {
+                        break;
+                    }
+                    if (idle) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        state.SetIterationTime(elapsed.count());
+
+        for (const ThreadResults& local : results) {
+            totals.alloc_ns.merge(local.alloc_ns);
+            totals.free_ns.merge(local.free_ns);
+            totals.handoff_ns.merge(local.handoff_ns);
+            totals.alloc_retries += local.alloc_retries;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * producers * kMessagesPerProducer);
+    totals.alloc_ns.report(state, "alloc");
+    totals.free_ns.report(state, "free");
+    totals.handoff_ns.report(state, "handoff");
+    state.counters["alloc_retries"] = static_cast<double>(totals.alloc_retries);
+}
+
+static void ProducerConsumerShapes(benchmark::internal::Benchmark* b) {
+    b->Args({1, 1})->Args({1, 2})->Args({2, 1})->Args({2, 2})->Args({4, 4});
+    b->ArgNames({"producers", "consumers"})->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_CrossThreadFree, bench::HeapStrategy)->Apply(ProducerConsumerShapes);
+BENCHMARK_TEMPLATE(BM_CrossThreadFree, bench::PoolFastStrategy)->Apply(ProducerConsumerShapes);
+BENCHMARK_TEMPLATE(BM_CrossThreadFree, bench::MutexPoolStrategy<kPoolCapacity>)
+    ->Apply(ProducerConsumerShapes);
+BENCHMARK_TEMPLATE(BM_CrossThreadFree, bench::SpinlockPoolStrategy<kPoolCapacity>)
+    ->Apply(ProducerConsumerShapes);
+BENCHMARK_TEMPLATE(BM_CrossThreadFree, bench::PmrSynchronizedStrategy)
+    ->Apply(ProducerConsumerShapes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,273 @@
+/**
+ * @file cycle_benchmark.cpp
+ * @brief Cycle-level distributions of single allocate and deallocate operations
+ * @details Google Benchmark times whole iterations, which cannot resolve one 5-20 ns
+ * allocate_fast(). This program times every operation on its own with the serialized TSC
+ * reads from Intel's "How to Benchmark Code Execution Times" note:
+ * - start: lfence; rdtsc; lfence (earlier instructions retired, later ones not started)
+ * - stop: rdtscp; lfence (the operation retired, nothing after it started)
+ *
+ * The cost of an empty timed region is measured first and its minimum subtracted from every
+ * sample. Each case runs hot (one object allocated and freed back to back, everything in
+ * cache) and cold (a buffer larger than the last-level cache is read before every timed
+ * operation), for the registry pool and for new/delete. The output is a percentile table in
+ * TSC ticks, plus the nanoseconds of the median using the TSC frequency calibrated at start.
+ *
+ * TSC ticks are reference cycles: on CPUs with frequency scaling they differ from core
+ * cycles, so fix the frequency (or compare only runs on the same machine). The thread is
+ * pinned to one CPU. On non-x86 targets steady_clock nanoseconds are used instead.
+ *
+ * This is not a Google Benchmark program: it has its own command line.
+ * @code
+ * cycle_benchmark [--samples=100000] [--cold-samples=1000] [--csv]
+ * @endcode
+ * @ingroup benchmarks
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "allocation_strategies.h"
+#include "benchmark_common.h"
+#include "latency_samples.h"
+#include "thread_topology.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define LFMP_CYCLE_BENCH_HAVE_TSC 1
+#else
+#define LFMP_CYCLE_BENCH_HAVE_TSC 0
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace lfmemorypool;
+
+namespace {
+
+using Object = Payload<64>;
+
+constexpr std::size_t kPoolCapacity = 4096;
+constexpr std::size_t kWarmupOperations = 10000;
+constexpr std::size_t kOverheadSamples = 100000;
+
+struct CycleOptions {
+    std::size_t samples = 100000;     // Per hot case
+    std::size_t cold_samples = 1000;  // Per cold case: each one walks the eviction buffer
+    bool csv = false;
+};
+
+/// Timestamp before the timed operation
+inline std::uint64_t ticks_start() noexcept {
+#if LFMP_CYCLE_BENCH_HAVE_TSC
+    _mm_lfence();
+    const std::uint64_t ticks = __rdtsc();
+    _mm_lfence();
+    return ticks;
+#else
+    return static_cast<std::uint64_t>(bench::now_ns());
+#endif
+}
+
+/// Timestamp after the timed operation
+inline std::uint64_t ticks_stop() noexcept {
+#if LFMP_CYCLE_BENCH_HAVE_TSC
+    unsigned int aux;
+    const std::uint64_t ticks = __rdtscp(&aux);
+    _mm_lfence();
+    return ticks;
+#else
+    return static_cast<std::uint64_t>(bench::now_ns());
+#endif
+}
+
+/// TSC ticks per nanosecond, measured against steady_clock over ~50 ms
+double calibrate_ticks_per_ns() {
+#if LFMP_CYCLE_BENCH_HAVE_TSC
+    const std::int64_t ns_start = bench::now_ns();
+    const std::uint64_t ticks = ticks_start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const std::uint64_t elapsed_ticks = ticks_stop() - ticks;
+    return static_cast<double>(elapsed_ticks) /
+           static_cast<double>(bench::now_ns() - ns_start);
+#else
+    return 1.0;
+#endif
+}
+
+/// Minimum cost of an empty timed region, subtracted from every sample
+std::uint64_t measure_overhead() {
+    std::uint64_t overhead = UINT64_MAX;
+    for (std::size_t i = 0; i < kOverheadSamples; ++i) {
+        const std::uint64_t start = ticks_start();
+        overhead = std::min(overhead, ticks_stop() - start);
+    }
+    return overhead;
+}
+
+/// Reads a buffer twice the last-level cache to push the allocator's lines out of every level
+class CacheEvictor {
+   public:
+    CacheEvictor() : buffer_(eviction_bytes(), 1) {
+    }
+
+    void evict() {
+        unsigned char sum = 0;
+        for (std::size_t i = 0; i < buffer_.size(); i += 64) {
+            sum += *static_cast<volatile unsigned char*>(&buffer_[i]);
+        }
+        sink_ += sum;
+    }
+
+   private:
+    static std::size_t eviction_bytes() {
+        long llc = 0;
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+        llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+        return std::max<std::size_t>(2 * static_cast<std::size_t>(std::max(llc, 0L)),
+                                     64u << 20);
+    }
+
+    std::vector<unsigned char> buffer_;
+    unsigned sink_ = 0;
+};
+
+struct CaseResult {
+    std::string name;
+    bench::LatencySamples ticks;
+};
+
+/**
+ * @brief Time `samples` allocate/deallocate pairs, each operation separately
+ * @details Hot: the pairs run back to back, so the pool's hint and slot flags stay cached
+ * (the hint walks the slots in order). Cold: the evictor runs before each timed operation.
+ * Only one object is live at a time, so the pool's first probe always succeeds and the fast
+ * path is what is measured, not the probe length.
+ */
+template <typename Strategy>
+void time_operations(const char* strategy, bool cold, std::size_t samples,
+                     std::uint64_t overhead, CacheEvictor& evictor,
+                     std::vector<CaseResult>& results) {
+    const char* cache = cold ? "cold" : "hot";
+    CaseResult alloc{std::string(strategy) + "/allocate/" + cache, {}};
+    CaseResult free{std::string(strategy) + "/deallocate/" + cache, {}};
+    alloc.ticks.reserve(samples);
+    free.ticks.reserve(samples);
+
+    for (std::size_t i = 0; i < kWarmupOperations; ++i) {
+        Strategy::deallocate(Strategy::template allocate<Object>(static_cast<int>(i)));
+    }
+
+    const auto sample = [overhead](std::uint64_t start, std::uint64_t stop) {
+        const std::uint64_t ticks = stop - start;
+        return static_cast<std::int64_t>(ticks > overhead ? ticks - overhead : 0);
+    };
+    for (std::size_t i = 0; i < samples; ++i) {
+        if (cold) {
+            evictor.evict();
+        }
+        std::uint64_t start = ticks_start();
+        Object* obj = Strategy::template allocate<Object>(static_cast<int>(i));
+        std::uint64_t stop = ticks_stop();
+        alloc.ticks.add(sample(start, stop));
+        if (!obj) {
+            std::fprintf(stderr, "%s: allocation failed\n", alloc.name.c_str());
+            break;
+        }
+
+        if (cold) {
+            evictor.evict();
+        }
+        start = ticks_start();
+        Strategy::deallocate(obj);
+        stop = ticks_stop();
+        free.ticks.add(sample(start, stop));
+    }
+
+    results.push_back(std::move(alloc));
+    results.push_back(std::move(free));
+}
+
+bool parse_options(int argc, char** argv, CycleOptions& options) {
+    bool valid = true;
+    for (int i = 1; i < argc && valid; ++i) {
+        std::string value;
+        if (parse_option(argv[i], "--samples", value)) {
+            valid = parse_number(value, options.samples);
+        } else if (parse_option(argv[i], "--cold-samples", value)) {
+            valid = parse_number(value, options.cold_samples);
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            options.csv = true;
+        } else {
+            valid = false;
+        }
+    }
+    if (!valid || options.samples == 0 || options.cold_samples == 0) {
+        std::fprintf(stderr, "usage: %s [--samples=N] [--cold-samples=N] [--csv]\n", argv[0]);
+        return false;
+    }
+    return true;
+}
+
+void print_results(std::vector<CaseResult>& results, double ticks_per_ns, bool csv) {
+    constexpr double kQuantiles[] = {0.0, 0.25, 0.50, 0.75, 0.90, 0.99, 0.999, 1.0};
+    if (csv) {
+        std::printf("case,samples,min,p25,p50,p75,p90,p99,p999,max,p50_ns\n");
+    } else {
+        std::printf("%-26s %8s %7s %7s %7s %7s %7s %7s %7s %9s %8s\n", "case", "samples", "min",
+                    "p25", "p50", "p75", "p90", "p99", "p99.9", "max", "p50_ns");
+    }
+    for (CaseResult& result : results) {
+        std::printf(csv ? "%s,%zu" : "%-26s %8zu", result.name.c_str(), result.ticks.size());
+        for (double q : kQuantiles) {
+            std::printf(csv ? ",%.0f" : (q == 1.0 ? " %9.0f" : " %7.0f"),
+                        result.ticks.percentile(q));
+        }
+        std::printf(csv ? ",%.1f\n" : " %8.1f\n", result.ticks.percentile(0.50) / ticks_per_ns);
+    }
+}
+
+}  // namespace
+
+DEFINE_LOCKFREE_POOL(Object, kPoolCapacity);
+
+int main(int argc, char** argv) {
+    CycleOptions options;
+    if (!parse_options(argc, argv, options)) {
+        return 1;
+    }
+
+    const auto cpus = bench::available_cpus();
+    bench::ScopedThreadPin pin(cpus.empty() ? -1 : cpus.front().cpu);
+    if (!pin.is_pinned()) {
+        std::fprintf(stderr, "note: could not pin to one CPU; TSC samples may migrate\n");
+    }
+
+    const double ticks_per_ns = calibrate_ticks_per_ns();
+    const std::uint64_t overhead = measure_overhead();
+    std::fprintf(stderr, "%s: %.3f ticks/ns, timing overhead %llu ticks (subtracted)\n",
+                 LFMP_CYCLE_BENCH_HAVE_TSC ? "rdtsc/rdtscp" : "steady_clock", ticks_per_ns,
+                 static_cast<unsigned long long>(overhead));
+
+    CacheEvictor evictor;
+    std::vector<CaseResult> results;
+    for (bool cold : {false, true}) {
+        const std::size_t samples = cold ? options.cold_samples : options.samples;
+        time_operations<bench::PoolFastStrategy>("PoolFast", cold, samples, overhead, evictor,
+                                                 results);
+        time_operations<bench::HeapStrategy>("Heap", cold, samples, overhead, evictor, results);
+    }
+    print_results(results, ticks_per_ns, options.csv);
+    return 0;
+}
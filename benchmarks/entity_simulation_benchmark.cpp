@@ -0,0 +1,217 @@
+/**
+ * @file entity_simulation_benchmark.cpp
+ * @brief Macro benchmark: game-style entity simulation with spawn/despawn churn
+ * @details Every iteration simulates one frame of a world of pooled entities:
+ * - every live entity is integrated (position, velocity, health);
+ * - entities that fire spawn short-lived projectiles, which are moved and expire after a few
+ *   frames;
+ * - a fraction of entities die each frame and are replaced by newly spawned ones.
+ *
+ * Entities (~128 bytes) and projectiles (~32 bytes) come from two DEFINE_LOCKFREE_POOL pools,
+ * so each frame mixes updates of live objects with allocation churn of two sizes, and the
+ * live set becomes scattered over the pool. The benchmark reports frames per second,
+ * allocations per frame and frame-time percentiles, with the pool and with new/delete.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "allocation_strategies.h"
+#include "latency_samples.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kMaxEntities = 1 << 14;
+constexpr std::size_t kMaxProjectiles = 1 << 15;
+constexpr int kWarmupFrames = 64;  // Reach steady-state churn before timing
+constexpr float kDt = 1.0f / 60.0f;
+
+/// Simulated actor (~128 bytes)
+struct Entity {
+    float position[3];
+    float velocity[3];
+    float orientation[4];
+    float health;
+    float fire_cooldown;
+    std::uint32_t id;
+    std::uint32_t team;
+    unsigned char state[64];
+
+    Entity(std::uint32_t entity_id, float x, float z)
+        : position{x, 0.0f, z},
+          velocity{1.0f, 0.0f, 0.5f},
+          orientation{0.0f, 0.0f, 0.0f, 1.0f},
+          health(100.0f),
+          fire_cooldown(0.0f),
+          id(entity_id),
+          team(entity_id & 1),
+          state{} {
+    }
+};
+
+/// Short-lived projectile (~32 bytes)
+struct Projectile {
+    float position[3];
+    float velocity[3];
+    std::uint32_t owner;
+    std::uint32_t frames_left;
+
+    Projectile(const Entity& shooter, std::uint32_t lifetime)
+        : position{shooter.position[0], shooter.position[1], shooter.position[2]},
+          velocity{shooter.velocity[0] * 4.0f, 0.0f, shooter.velocity[2] * 4.0f},
+          owner(shooter.id),
+          frames_left(lifetime) {
+    }
+};
+
+/// The world: live objects are kept in dense pointer arrays, removed by swap-and-pop
+template <typename Strategy>
+class World {
+   public:
+    World(std::size_t entities, unsigned seed) : rng_(seed) {
+        entities_.reserve(kMaxEntities);
+        projectiles_.reserve(kMaxProjectiles);
+        for (std::size_t i = 0; i < entities; ++i) {
+            spawn_entity();
+        }
+    }
+
+    ~World() {
+        for (Entity* entity : entities_) {
+            Strategy::deallocate(entity);
+        }
+        for (Projectile* projectile : projectiles_) {
+            Strategy::deallocate(projectile);
+        }
+    }
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    /// Advance one frame; returns the number of allocations it made
+    std::size_t step() {
+        std::size_t allocations = 0;
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+        for (std::size_t i = 0; i < entities_.size();) {
+            Entity& entity = *entities_[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                entity.position[axis] += entity.velocity[axis] * kDt;
+            }
+            entity.fire_cooldown -= kDt;
+            if (entity.fire_cooldown <= 0.0f && projectiles_.size() < kMaxProjectiles) {
+                entity.fire_cooldown = 0.25f + chance(rng_);
+                if (Projectile* projectile =
+                        Strategy::template allocate<Projectile>(entity, 8 + (rng_() & 15))) {
+                    projectiles_.push_back(projectile);
+                    ++allocations;
+                }
+            }
+            entity.health -= chance(rng_) * 4.0f;  // Lives ~50 frames: ~2% die per frame
+            if (entity.health <= 0.0f) {
+                despawn_entity(i);
+                continue;
+            }
+            ++i;
+        }
+
+        for (std::size_t i = 0; i < projectiles_.size();) {
+            Projectile& projectile = *projectiles_[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                projectile.position[axis] += projectile.velocity[axis] * kDt;
+            }
+            if (--projectile.frames_left == 0) {
+                Strategy::deallocate(projectiles_[i]);
+                projectiles_[i] = projectiles_.back();
+                projectiles_.pop_back();
+                continue;
+            }
+            ++i;
+        }
+
+        // Respawn back to the target population
+        while (entities_.size() < target_ && spawn_entity()) {
+            ++allocations;
+        }
+        return allocations;
+    }
+
+    std::size_t live_objects() const {
+        return entities_.size() + projectiles_.size();
+    }
+
+   private:
+    bool spawn_entity() {
+        std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+        Entity* entity = Strategy::template allocate<Entity>(next_id_++, coordinate(rng_),
+                                                             coordinate(rng_));
+        if (!entity) {
+            return false;
+        }
+        entities_.push_back(entity);
+        target_ = std::max(target_, entities_.size());
+        return true;
+    }
+
+    void despawn_entity(std::size_t index) {
+        Strategy::deallocate(entities_[index]);
+        entities_[index] = entities_.back();
+        entities_.pop_back();
+    }
+
+    std::mt19937 rng_;
+    std::vector<Entity*> entities_;
+    std::vector<Projectile*> projectiles_;
+    std::size_t target_ = 0;
+    std::uint32_t next_id_ = 0;
+};
+
+}  // namespace
+
+DEFINE_LOCKFREE_POOL(Entity, 2 * kMaxEntities);
+DEFINE_LOCKFREE_POOL(Projectile, 2 * kMaxProjectiles);
+
+/**
+ * @brief One simulated frame of range(0) entities per iteration
+ * @details Runs single-threaded, like a game loop's simulation step; the first
+ * kWarmupFrames frames are untimed so births and deaths are already balanced.
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+static void BM_EntitySimulation(benchmark::State& state) {
+    World<Strategy> world(static_cast<std::size_t>(state.range(0)), 7);
+    for (int frame = 0; frame < kWarmupFrames; ++frame) {
+        world.step();
+    }
+
+    bench::LatencySamples frame_ns;
+    std::size_t allocations = 0;
+    for (auto _ : state) {
+        const std::int64_t start = bench::now_ns();
+        allocations += world.step();
+        frame_ns.add(bench::now_ns() - start);
+    }
+
+    state.counters["frames_per_sec"] =
+        benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+    state.counters["allocs_per_frame"] =
+        static_cast<double>(allocations) / static_cast<double>(state.iterations());
+    state.counters["live_objects"] = static_cast<double>(world.live_objects());
+    frame_ns.report(state, "frame");
+}
+
+static void EntityArgs(benchmark::internal::Benchmark* b) {
+    b->Arg(1000)->Arg(8000)->ArgName("entities")->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_TEMPLATE(BM_EntitySimulation, bench::HeapStrategy)->Apply(EntityArgs);
+BENCHMARK_TEMPLATE(BM_EntitySimulation, bench::PoolFastStrategy)->Apply(EntityArgs);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,187 @@
+/**
+ * @file fanout_benchmark.cpp
+ * @brief MessageBus fan-out against std::shared_ptr messages in mutex-protected queues
+ * @details One publisher sends 64-byte quotes to range(0) subscriber threads, each of which
+ * reads every message. The buses:
+ * - MessageBus: every quote is built once in a pool slot that carries its reference count,
+ *   and a pointer to it is pushed to each subscriber's SPSC ring (src/MessageBus.h)
+ * - SharedPtrFanOut: std::make_shared per quote, a copy of the shared_ptr pushed to each
+ *   subscriber's std::deque behind its own std::mutex
+ *
+ * At most kInFlight quotes are outstanding: the publisher waits for a free pool slot or for
+ * room in a subscriber's queue. Reports deliveries (messages x subscribers) per second.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../src/MessageBus.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kInFlight = 1024;
+constexpr std::uint64_t kBatch = 4096;
+
+/// Market-data update, one cache line
+struct Quote {
+    std::uint64_t sequence;
+    std::uint32_t instrument;
+    std::uint32_t flags;
+    double bid;
+    double ask;
+    std::uint64_t bid_size;
+    std::uint64_t ask_size;
+    std::uint64_t exchange_time;
+    std::uint64_t receive_time;
+};
+
+class PooledFanOut {
+   public:
+    explicit PooledFanOut(std::size_t subscribers)
+        : bus_(kInFlight, kInFlight, subscribers) {
+        for (std::size_t i = 0; i < subscribers; ++i) {
+            ids_.push_back(bus_.subscribe());
+        }
+    }
+
+    void publish(const Quote& quote) {
+        while (!bus_.try_publish(quote)) {
+            std::this_thread::yield();
+        }
+    }
+
+    bool consume(std::size_t subscriber, std::uint64_t& checksum) {
+        MessageBus<Quote>::Handle message;
+        if (!bus_.poll(ids_[subscriber], message)) {
+            return false;
+        }
+        checksum += message->sequence + message->bid_size;
+        return true;
+    }
+
+   private:
+    MessageBus<Quote> bus_;
+    std::vector<std::size_t> ids_;
+};
+
+class SharedPtrFanOut {
+   public:
+    explicit SharedPtrFanOut(std::size_t subscribers) {
+        for (std::size_t i = 0; i < subscribers; ++i) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+    }
+
+    void publish(const Quote& quote) {
+        const auto message = std::make_shared<const Quote>(quote);
+        for (auto& queue : queues_) {
+            for (;;) {
+                {
+                    std::lock_guard<std::mutex> lock(queue->mutex);
+                    if (queue->messages.size() < kInFlight) {
+                        queue->messages.push_back(message);
+                        break;
+                    }
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    bool consume(std::size_t subscriber, std::uint64_t& checksum) {
+        std::shared_ptr<const Quote> message;
+        {
+            Queue& queue = *queues_[subscriber];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.messages.empty()) {
+                return false;
+            }
+            message = std::move(queue.messages.front());
+            queue.messages.pop_front();
+        }
+        checksum += message->sequence + message->bid_size;
+        return true;
+    }
+
+   private:
+    struct alignas(cache_line_size) Queue {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<const Quote>> messages;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+};
+
+/// Messages one subscriber has read, on its own cache line
+struct alignas(cache_line_size) Progress {
+    std::atomic<std::uint64_t> received{0};
+};
+
+}  // namespace
+
+/**
+ * @brief kBatch quotes per iteration fanned out to range(0) subscribers
+ * @details Subscriber threads run for the whole benchmark; an iteration ends when every
+ * subscriber has read the batch.
+ * @ingroup benchmarks
+ */
+template <typename Bus>
+static void BM_FanOut(benchmark::State& state) {
+    const auto subscribers = static_cast<std::size_t>(state.range(0));
+    Bus bus(subscribers);
+    std::vector<Progress> progress(subscribers);
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < subscribers; ++i) {
+        threads.emplace_back([&bus, &progress, &stop, i] {
+            std::uint64_t checksum = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (bus.consume(i, checksum)) {
+                    progress[i].received.fetch_add(1, std::memory_order_release);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            benchmark::DoNotOptimize(checksum);
+        });
+    }
+
+    std::uint64_t sequence = 0;
+    for (auto _ : state) {
+        for (std::uint64_t n = 0; n < kBatch; ++n, ++sequence) {
+            bus.publish(Quote{sequence, static_cast<std::uint32_t>(sequence % 512), 0, 100.25,
+                              100.5, 300, 200, sequence, sequence});
+        }
+        for (const auto& p : progress) {
+            while (p.received.load(std::memory_order_acquire) < sequence) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBatch * subscribers));
+}
+
+static void SubscriberCounts(benchmark::internal::Benchmark* b) {
+    b->ArgName("subscribers")->Arg(5)->Arg(10)->Arg(20)->UseRealTime();
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_FanOut, PooledFanOut)->Apply(SubscriberCounts);
+BENCHMARK_TEMPLATE(BM_FanOut, SharedPtrFanOut)->Apply(SubscriberCounts);
+
+BENCHMARK_MAIN();
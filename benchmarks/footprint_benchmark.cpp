@@ -0,0 +1,118 @@
+/**
+ * @file footprint_benchmark.cpp
+ * @brief Memory footprint and page faults of LockFreeMemoryPool versus malloc
+ * @details For several capacities and object sizes, builds a live set of `capacity` objects
+ * once in a full LockFreeMemoryPool and once with new, and reports the resident memory and
+ * minor page faults it took. The pool numbers show the cost of the Segment layout: each slot
+ * holds the object plus a std::atomic<bool> flag, padded up to the object's alignment.
+ *
+ * Each benchmark runs a single iteration: repeating it would measure reuse of memory the
+ * process already owns rather than the footprint of a fresh live set.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "benchmark_common.h"
+#include "process_memory.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+// Keep each live set under this size so the sweep fits on ordinary machines
+constexpr std::size_t kMaxLiveSetBytes = std::size_t{512} << 20;
+
+void report_footprint(benchmark::State& state, const bench::MemoryDelta& delta,
+                      std::size_t live_objects, std::size_t object_bytes) {
+    const double bytes_per_object = delta.rss_bytes / static_cast<double>(live_objects);
+    state.counters["live_objects"] = static_cast<double>(live_objects);
+    state.counters["object_bytes"] = static_cast<double>(object_bytes);
+    state.counters["rss_bytes"] = delta.rss_bytes;
+    state.counters["minor_faults"] = delta.minor_faults;
+    state.counters["bytes_per_object"] = bytes_per_object;
+    state.counters["overhead_pct"] = (bytes_per_object / object_bytes - 1.0) * 100.0;
+}
+
+}  // namespace
+
+/**
+ * @brief Resident memory of a full pool of Payload<N>
+ * @details slot_bytes is sizeof the pool's Segment, i.e. object + flag + padding.
+ * @ingroup benchmarks
+ */
+template <std::size_t N>
+static void BM_PoolFootprint(benchmark::State& state) {
+    using Object = Payload<N>;
+    const auto capacity = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<Object*> live(capacity);  // Touched up front: not part of the footprint
+
+        bench::MemoryDelta delta;
+        auto pool = std::make_unique<LockFreeMemoryPool<Object>>(capacity);
+        for (std::size_t i = 0; i < capacity; ++i) {
+            live[i] = pool->allocate_fast(static_cast<int>(i));
+        }
+        delta.sample();
+
+        report_footprint(state, delta, capacity, sizeof(Object));
+        state.counters["slot_bytes"] = static_cast<double>(sizeof(SegmentOf<Object>));
+
+        for (Object* obj : live) {
+            pool->deallocate_fast(obj);
+        }
+    }
+}
+
+/**
+ * @brief Resident memory of the same live set allocated with new
+ * @ingroup benchmarks
+ */
+template <std::size_t N>
+static void BM_MallocFootprint(benchmark::State& state) {
+    using Object = Payload<N>;
+    const auto capacity = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        std::vector<Object*> live(capacity);  // Touched up front: not part of the footprint
+
+        bench::MemoryDelta delta;
+        for (std::size_t i = 0; i < capacity; ++i) {
+            live[i] = new Object(static_cast<int>(i));
+        }
+        delta.sample();
+
+        report_footprint(state, delta, capacity, sizeof(Object));
+
+        for (Object* obj : live) {
+            delete obj;
+        }
+    }
+}
+
+template <std::size_t N>
+static void FootprintCapacities(benchmark::internal::Benchmark* b) {
+    for (std::size_t capacity : {std::size_t{1} << 10, std::size_t{1} << 14,
+                                 std::size_t{1} << 18, std::size_t{1} << 20}) {
+        if (capacity * N <= kMaxLiveSetBytes) {
+            b->Arg(static_cast<int64_t>(capacity));
+        }
+    }
+    b->ArgName("capacity")->Iterations(1)->Unit(benchmark::kMillisecond);
+}
+
+#define FOOTPRINT_BENCHMARKS(N)                                             \
+    BENCHMARK_TEMPLATE(BM_PoolFootprint, N)->Apply(FootprintCapacities<N>); \
+    BENCHMARK_TEMPLATE(BM_MallocFootprint, N)->Apply(FootprintCapacities<N>)
+
+FOOTPRINT_BENCHMARKS(8);
+FOOTPRINT_BENCHMARKS(64);
+FOOTPRINT_BENCHMARKS(100);
+FOOTPRINT_BENCHMARKS(400);
+FOOTPRINT_BENCHMARKS(4096);
+
+BENCHMARK_MAIN();
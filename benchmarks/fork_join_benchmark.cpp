@@ -0,0 +1,162 @@
+/**
+ * @file fork_join_benchmark.cpp
+ * @brief Parallel fib on WorkStealingExecutor against a std::function thread pool
+ * @details fib(kFibN) forks one child task per call down to kSerialCutoff, below which it
+ * recurses serially; a parent waits for its child by executing other tasks. The executors:
+ * - WorkStealingExecutor: per-worker Chase-Lev deques, tasks in pooled cache-line slots with
+ *   the callable stored inline (src/WorkStealingExecutor.h)
+ * - FunctionThreadPool: one std::deque of std::function behind a std::mutex; the fib closure
+ *   is larger than std::function's small buffer, so every spawn allocates
+ *
+ * Reports tasks per second for 1-8 workers.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../src/WorkStealingExecutor.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr int kFibN = 30;
+constexpr int kSerialCutoff = 12;
+
+/// Central-queue pool: std::function tasks in a mutex-protected std::deque
+class FunctionThreadPool {
+   public:
+    explicit FunctionThreadPool(std::size_t threads) {
+        for (std::size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                        if (tasks_.empty()) {
+                            return;
+                        }
+                        task = std::move(tasks_.front());
+                        tasks_.pop_front();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~FunctionThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        ready_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    template <typename F>
+    void spawn(F&& fn) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.emplace_back(std::forward<F>(fn));
+        }
+        ready_.notify_one();
+    }
+
+    template <typename Pred>
+    void wait_until(Pred&& done) {
+        while (!done()) {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!tasks_.empty()) {
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+            }
+            if (task) {
+                task();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+   private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> threads_;
+    bool stopping_ = false;
+};
+
+std::uint64_t fib_serial(int n) {
+    return n < 2 ? static_cast<std::uint64_t>(n) : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+template <typename Executor>
+std::uint64_t fib_parallel(Executor& executor, int n) {
+    if (n < kSerialCutoff) {
+        return fib_serial(n);
+    }
+    std::uint64_t left = 0;
+    std::atomic<bool> done{false};
+    executor.spawn([&executor, &left, &done, n] {
+        left = fib_parallel(executor, n - 1);
+        done.store(true, std::memory_order_release);
+    });
+    const std::uint64_t right = fib_parallel(executor, n - 2);
+    executor.wait_until([&done] { return done.load(std::memory_order_acquire); });
+    return left + right;
+}
+
+/// Tasks fib_parallel(n) spawns
+std::uint64_t spawned_tasks(int n) {
+    return n < kSerialCutoff ? 0 : 1 + spawned_tasks(n - 1) + spawned_tasks(n - 2);
+}
+
+}  // namespace
+
+/**
+ * @brief fib(kFibN) forked down to kSerialCutoff on range(0) workers
+ * @details The executor is created outside the timed loop; the calling thread joins in
+ * while it waits for the root.
+ * @ingroup benchmarks
+ */
+template <typename Executor>
+static void BM_ForkJoinFib(benchmark::State& state) {
+    Executor executor(static_cast<std::size_t>(state.range(0)));
+    const std::uint64_t expected = fib_serial(kFibN);
+
+    for (auto _ : state) {
+        const std::uint64_t result = fib_parallel(executor, kFibN);
+        if (result != expected) {
+            state.SkipWithError("wrong fib result");
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * spawned_tasks(kFibN));
+}
+
+static void WorkerCounts(benchmark::internal::Benchmark* b) {
+    b->ArgName("workers")->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_ForkJoinFib, WorkStealingExecutor)->Apply(WorkerCounts);
+BENCHMARK_TEMPLATE(BM_ForkJoinFib, FunctionThreadPool)->Apply(WorkerCounts);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,367 @@
+/**
+ * @file handoff_latency_benchmark.cpp
+ * @brief Latency of handing pooled objects between two pinned threads
+ * @details A producer and a consumer, pinned to two different physical cores when the
+ * machine has them, exchange 64-byte messages over a 1024-entry SPSC ring carrying:
+ * - IndexTransport<B>: 32-bit pool slot indices through SpscHandoffChannel, publishing
+ *   every B messages (src/SpscHandoffChannel.h)
+ * - PointerTransport: pool object pointers through a ring that publishes every message
+ * - CopyTransport: the messages themselves, copied into and out of the ring (no pool)
+ *
+ * BM_HandoffStream streams messages as fast as the consumer takes them and reports the
+ * throughput and sampled one-way latency (send to receive, queueing included).
+ * BM_HandoffRoundTrip bounces one message at a time between the threads over two rings and
+ * reports the round-trip latency, with every send flushed.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../src/SpscHandoffChannel.h"
+#include "latency_samples.h"
+#include "spsc_ring.h"
+#include "thread_topology.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kRingCapacity = 1024;
+constexpr std::size_t kPoolCapacity = 2 * kRingCapacity;  // Headroom for the linear probe
+constexpr std::size_t kStreamMessages = 1 << 16;          // Per iteration
+constexpr std::size_t kRoundTrips = 1 << 12;              // Per iteration
+constexpr std::size_t kSampleEvery = 16;
+
+/// Message handed between the stages, one cache line
+struct Message {
+    std::int64_t sent_ns;
+    std::uint64_t sequence;
+    unsigned char body[48];
+
+    Message() = default;
+    Message(std::int64_t sent, std::uint64_t seq) : sent_ns(sent), sequence(seq), body{} {
+    }
+};
+
+/// Pool slot indices through SpscHandoffChannel, published every Batch messages
+template <std::size_t Batch>
+class IndexTransport {
+   public:
+    IndexTransport() : pool_(kPoolCapacity), channel_(pool_, kRingCapacity, Batch) {
+    }
+
+    bool try_send(std::int64_t sent_ns, std::uint64_t sequence) {
+        Message* message = pool_.allocate_fast(sent_ns, sequence);
+        if (!message) {
+            channel_.flush();
+            return false;
+        }
+        if (!channel_.try_send(message)) {
+            pool_.deallocate_fast(message);
+            return false;
+        }
+        return true;
+    }
+
+    void flush() {
+        channel_.flush();
+    }
+
+    bool try_receive(std::int64_t& sent_ns, std::uint64_t& sequence) {
+        Message* message = channel_.try_receive();
+        if (!message) {
+            return false;
+        }
+        sent_ns = message->sent_ns;
+        sequence = message->sequence;
+        pool_.deallocate_fast(message);
+        return true;
+    }
+
+   private:
+    LockFreeMemoryPool<Message> pool_;
+    SpscHandoffChannel<Message> channel_;
+};
+
+/// Pool object pointers through a ring that publishes on every push
+class PointerTransport {
+   public:
+    PointerTransport() : pool_(kPoolCapacity), ring_(std::make_unique<Ring>()) {
+    }
+
+    bool try_send(std::int64_t sent_ns, std::uint64_t sequence) {
+        Message* message = pool_.allocate_fast(sent_ns, sequence);
+        if (!message) {
+            return false;
+        }
+        if (!ring_->try_push(message)) {
+            pool_.deallocate_fast(message);
+            return false;
+        }
+        return true;
+    }
+
+    void flush() {
+    }
+
+    bool try_receive(std::int64_t& sent_ns, std::uint64_t& sequence) {
+        Message* message = nullptr;
+        if (!ring_->try_pop(message)) {
+            return false;
+        }
+        sent_ns = message->sent_ns;
+        sequence = message->sequence;
+        pool_.deallocate_fast(message);
+        return true;
+    }
+
+   private:
+    using Ring = bench::SpscRing<Message*, kRingCapacity>;
+
+    LockFreeMemoryPool<Message> pool_;
+    std::unique_ptr<Ring> ring_;
+};
+
+/// Messages copied into and out of the ring
+class CopyTransport {
+   public:
+    CopyTransport() : ring_(std::make_unique<Ring>()) {
+    }
+
+    bool try_send(std::int64_t sent_ns, std::uint64_t sequence) {
+        return ring_->try_push(Message(sent_ns, sequence));
+    }
+
+    void flush() {
+    }
+
+    bool try_receive(std::int64_t& sent_ns, std::uint64_t& sequence) {
+        Message message;
+        if (!ring_->try_pop(message)) {
+            return false;
+        }
+        sent_ns = message.sent_ns;
+        sequence = message.sequence;
+        return true;
+    }
+
+   private:
+    using Ring = bench::SpscRing<Message, kRingCapacity>;
+
+    std::unique_ptr<Ring> ring_;
+};
+
+/// Two CPUs on different physical cores if there are any; -1 (unpinned) when unavailable
+std::vector<int> pair_cpus() {
+    const auto cpus = bench::available_cpus();
+    std::vector<int> order = bench::placement_cpus(bench::ThreadPlacement::SameSocket, cpus);
+    if (order.size() < 2) {
+        order.clear();
+        for (const bench::CpuInfo& info : cpus) {
+            order.push_back(info.cpu);
+        }
+    }
+    order.resize(2, order.empty() ? -1 : order.back());
+    return order;
+}
+
+/// Spins on a failed poll a few times before giving the core away
+class IdleBackoff {
+   public:
+    void idle() {
+        if (++spins_ > 64) {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset() {
+        spins_ = 0;
+    }
+
+   private:
+    unsigned spins_ = 0;
+};
+
+}  // namespace
+
+/**
+ * @brief Producer streams kStreamMessages to the consumer
+ * @details Threads are created and pinned outside the timed region and released together;
+ * the iteration time runs until the consumer has received every message. Every
+ * kSampleEvery-th message is timed from just before its send to its receipt.
+ * @ingroup benchmarks
+ */
+template <typename Transport>
+static void BM_HandoffStream(benchmark::State& state) {
+    const std::vector<int> cpus = pair_cpus();
+    bench::LatencySamples latency;
+    bool pinned = true;
+
+    for (auto _ : state) {
+        Transport transport;
+        std::atomic<int> ready{0};
+        std::atomic<bool> go{false};
+        std::atomic<bool> producer_pinned{false};
+        std::atomic<bool> consumer_pinned{false};
+
+        std::thread consumer([&] {
+            bench::ScopedThreadPin pin(cpus[1]);
+            consumer_pinned = pin.is_pinned();
+            latency.reserve(latency.size() + kStreamMessages / kSampleEvery);
+            ready.fetch_add(1, std::memory_order_release);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            IdleBackoff backoff;
+            for (std::size_t received = 0; received < kStreamMessages;) {
+                std::int64_t sent_ns = 0;
+                std::uint64_t sequence = 0;
+                if (!transport.try_receive(sent_ns, sequence)) {
+                    backoff.idle();
+                    continue;
+                }
+                backoff.reset();
+                if (sequence % kSampleEvery == 0) {
+                    latency.add(bench::now_ns() - sent_ns);
+                }
+                ++received;
+            }
+        });
+        std::thread producer([&] {
+            bench::ScopedThreadPin pin(cpus[0]);
+            producer_pinned = pin.is_pinned();
+            ready.fetch_add(1, std::memory_order_release);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            IdleBackoff backoff;
+            for (std::uint64_t sequence = 0; sequence < kStreamMessages;) {
+                const std::int64_t sent_ns = sequence % kSampleEvery == 0 ? bench::now_ns() : 0;
+                if (!transport.try_send(sent_ns, sequence)) {
+                    backoff.idle();
+                    continue;
+                }
+                backoff.reset();
+                ++sequence;
+            }
+            transport.flush();
+        });
+
+        while (ready.load(std::memory_order_acquire) < 2) {
+            std::this_thread::yield();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        producer.join();
+        consumer.join();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        state.SetIterationTime(elapsed.count());
+        pinned = pinned && producer_pinned && consumer_pinned;
+    }
+
+    state.SetItemsProcessed(state.iterations() * kStreamMessages);
+    latency.report(state, "one_way");
+    state.counters["pinned"] = pinned ? 1.0 : 0.0;
+}
+
+/**
+ * @brief One message at a time bounced between the two threads, kRoundTrips per iteration
+ * @details The initiator stamps a message, sends it and waits for the echo on a second
+ * transport; every round trip is timed.
+ * @ingroup benchmarks
+ */
+template <typename Transport>
+static void BM_HandoffRoundTrip(benchmark::State& state) {
+    const std::vector<int> cpus = pair_cpus();
+    bench::LatencySamples latency;
+    bool pinned = true;
+
+    for (auto _ : state) {
+        Transport forward;
+        Transport back;
+        std::atomic<int> ready{0};
+        std::atomic<bool> go{false};
+        std::atomic<bool> initiator_pinned{false};
+        std::atomic<bool> echo_pinned{false};
+
+        std::thread echo([&] {
+            bench::ScopedThreadPin pin(cpus[1]);
+            echo_pinned = pin.is_pinned();
+            ready.fetch_add(1, std::memory_order_release);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            IdleBackoff backoff;
+            for (std::size_t i = 0; i < kRoundTrips;) {
+                std::int64_t sent_ns = 0;
+                std::uint64_t sequence = 0;
+                if (!forward.try_receive(sent_ns, sequence)) {
+                    backoff.idle();
+                    continue;
+                }
+                backoff.reset();
+                while (!back.try_send(sent_ns, sequence)) {
+                    backoff.idle();
+                }
+                back.flush();
+                ++i;
+            }
+        });
+        std::thread initiator([&] {
+            bench::ScopedThreadPin pin(cpus[0]);
+            initiator_pinned = pin.is_pinned();
+            latency.reserve(latency.size() + kRoundTrips);
+            ready.fetch_add(1, std::memory_order_release);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            IdleBackoff backoff;
+            for (std::uint64_t sequence = 0; sequence < kRoundTrips; ++sequence) {
+                while (!forward.try_send(bench::now_ns(), sequence)) {
+                    backoff.idle();
+                }
+                forward.flush();
+                std::int64_t sent_ns = 0;
+                std::uint64_t echoed = 0;
+                while (!back.try_receive(sent_ns, echoed)) {
+                    backoff.idle();
+                }
+                backoff.reset();
+                latency.add(bench::now_ns() - sent_ns);
+            }
+        });
+
+        while (ready.load(std::memory_order_acquire) < 2) {
+            std::this_thread::yield();
+        }
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        initiator.join();
+        echo.join();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        state.SetIterationTime(elapsed.count());
+        pinned = pinned && initiator_pinned && echo_pinned;
+    }
+
+    state.SetItemsProcessed(state.iterations() * kRoundTrips);
+    latency.report(state, "round_trip");
+    state.counters["pinned"] = pinned ? 1.0 : 0.0;
+}
+
+BENCHMARK_TEMPLATE(BM_HandoffStream, IndexTransport<1>)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_HandoffStream, IndexTransport<16>)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_HandoffStream, IndexTransport<64>)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_HandoffStream, PointerTransport)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_HandoffStream, CopyTransport)->UseManualTime();
+
+BENCHMARK_TEMPLATE(BM_HandoffRoundTrip, IndexTransport<16>)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_HandoffRoundTrip, PointerTransport)->UseManualTime();
+BENCHMARK_TEMPLATE(BM_HandoffRoundTrip, CopyTransport)->UseManualTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+/**
+ * @file hash_map_benchmark.cpp
+ * @brief ConcurrentHashMap against std::unordered_map behind one std::shared_mutex
+ * @details All threads share one map over a key space of kKeySpace keys, about half of them
+ * present. Each operation picks a random key and:
+ * - read-heavy: finds it 90% of the time, inserts or erases it 5% of the time each;
+ * - write-heavy: inserts or erases it 45% of the time each, finds it 10% of the time.
+ *
+ * Inserts and erases balance, so the map stays half full. ConcurrentHashMap takes its nodes
+ * from a pool and locks one of 64 stripes; the baseline allocates a heap node per insert
+ * and takes a single reader-writer lock.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include "../src/ConcurrentHashMap.h"
+#include "benchmark_common.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::uint64_t kKeySpace = 1 << 16;
+
+/// std::unordered_map guarded by one std::shared_mutex
+class LockedUnorderedMap {
+   public:
+    explicit LockedUnorderedMap(std::size_t capacity) {
+        map_.reserve(capacity);
+    }
+
+    bool try_emplace(std::uint64_t key, std::uint64_t value) {
+        std::unique_lock lock(mutex_);
+        return map_.try_emplace(key, value).second;
+    }
+
+    bool find(std::uint64_t key, std::uint64_t& value) const {
+        std::shared_lock lock(mutex_);
+        const auto it = map_.find(key);
+        if (it == map_.end()) {
+            return false;
+        }
+        value = it->second;
+        return true;
+    }
+
+    bool erase(std::uint64_t key) {
+        std::unique_lock lock(mutex_);
+        return map_.erase(key) != 0;
+    }
+
+   private:
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::uint64_t, std::uint64_t> map_;
+};
+
+using PooledMap = ConcurrentHashMap<std::uint64_t, std::uint64_t>;
+
+/// One map per type, shared by every run and half filled on first use
+template <typename Map>
+Map& shared_map() {
+    static Map map(kKeySpace);
+    static const bool filled = [] {
+        for (std::uint64_t key = 0; key < kKeySpace; key += 2) {
+            static_cast<void>(map.try_emplace(key, key));
+        }
+        return true;
+    }();
+    static_cast<void>(filled);
+    return map;
+}
+
+}  // namespace
+
+/**
+ * @brief Random find/insert/erase mix with `ReadPercent`% finds on a shared map
+ * @ingroup benchmarks
+ */
+template <typename Map, int ReadPercent>
+static void BM_HashMapMix(benchmark::State& state) {
+    Map& map = shared_map<Map>();
+    std::uint64_t rng = 0x9e3779b97f4a7c15ULL * (state.thread_index() + 1);
+    std::uint64_t found = 0;
+
+    for (auto _ : state) {
+        const std::uint64_t r = next_random(rng);
+        const std::uint64_t key = r % kKeySpace;
+        const int roll = static_cast<int>((r >> 32) % 100);
+        if (roll < ReadPercent) {
+            std::uint64_t value;
+            found += map.find(key, value);
+        } else if (roll % 2 == 0) {
+            benchmark::DoNotOptimize(map.try_emplace(key, key));
+        } else {
+            benchmark::DoNotOptimize(map.erase(key));
+        }
+    }
+
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void HashMapThreads(benchmark::internal::Benchmark* b) {
+    b->ThreadRange(1, 64)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_HashMapMix, PooledMap, 90)
+    ->Name("BM_HashMapReadHeavy<Pooled>")
+    ->Apply(HashMapThreads);
+BENCHMARK_TEMPLATE(BM_HashMapMix, LockedUnorderedMap, 90)
+    ->Name("BM_HashMapReadHeavy<LockedUnorderedMap>")
+    ->Apply(HashMapThreads);
+BENCHMARK_TEMPLATE(BM_HashMapMix, PooledMap, 10)
+    ->Name("BM_HashMapWriteHeavy<Pooled>")
+    ->Apply(HashMapThreads);
+BENCHMARK_TEMPLATE(BM_HashMapMix, LockedUnorderedMap, 10)
+    ->Name("BM_HashMapWriteHeavy<LockedUnorderedMap>")
+    ->Apply(HashMapThreads);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file latency_samples.h
+ * @brief Collection of per-operation latency samples and percentile reporting
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Monotonic timestamp in nanoseconds
+inline std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Latency samples in nanoseconds
+ * @details Each thread records into its own instance; instances are merged after the
+ * threads are joined and reported once per benchmark run.
+ * @ingroup benchmarks
+ */
+class LatencySamples {
+   public:
+    void reserve(std::size_t count) {
+        samples_.reserve(count);
+    }
+
+    void add(std::int64_t nanoseconds) {
+        samples_.push_back(nanoseconds);
+    }
+
+    void merge(const LatencySamples& other) {
+        samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+    }
+
+    void clear() {
+        samples_.clear();
+    }
+
+    std::size_t size() const {
+        return samples_.size();
+    }
+
+    /// Sample at quantile q in [0, 1] (nearest rank); 0 when empty. Reorders the samples.
+    double percentile(double q) {
+        if (samples_.empty()) {
+            return 0.0;
+        }
+        const auto rank = static_cast<std::size_t>(q * static_cast<double>(samples_.size() - 1));
+        std::nth_element(samples_.begin(), samples_.begin() + rank, samples_.end());
+        return static_cast<double>(samples_[rank]);
+    }
+
+    /// Add `<prefix>_p50_ns`, `<prefix>_p99_ns` and `<prefix>_max_ns` counters to state
+    void report(benchmark::State& state, const std::string& prefix) {
+        state.counters[prefix + "_p50_ns"] = percentile(0.50);
+        state.counters[prefix + "_p99_ns"] = percentile(0.99);
+        state.counters[prefix + "_max_ns"] = percentile(1.0);
+    }
+
+   private:
+    std::vector<std::int64_t> samples_;
+};
+
+}  // namespace bench
@@ -0,0 +1,144 @@
+/**
+ * @file many_pools_benchmark.cpp
+ * @brief Random mixed workload across many registered pool types
+ * @details Real binaries register dozens of types with DEFINE_LOCKFREE_POOL and interleave
+ * allocations across them. Every registered type has its own pool (its own slot array and
+ * search hint) and its own instantiation of the allocation code, so spreading the same
+ * work over more types touches more data and more code.
+ *
+ * PooledType<I> generates distinct types from one template. A random sequence of
+ * (type, live slot) picks replaces objects in a fixed-size live set; only the number of
+ * types the picks are spread over changes between runs, so 1 type is the single-pool
+ * baseline. Dispatch goes through per-type function pointer tables for every run.
+ * Hardware counters (including L1I and iTLB misses) are reported where available.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "benchmark_common.h"
+#include "perf_counters.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kMaxTypes = 64;
+constexpr std::size_t kLiveObjects = 4096;
+constexpr std::size_t kOpsPerIteration = 1024;
+constexpr std::size_t kPickSequence = 1 << 16;  // Precomputed (type, slot) picks, reused
+
+/// A distinct pooled type per I; all have the same 64-byte layout
+template <std::size_t I>
+struct PooledType : Payload<64> {
+    explicit PooledType(int id) : Payload<64>(id + static_cast<int>(I)) {
+    }
+};
+
+}  // namespace
+
+// Registry entry for every PooledType<I>, as DEFINE_LOCKFREE_POOL would write per type.
+// Each pool can hold twice the whole live set: never exhausted, and at most half full
+// when all objects share one type.
+namespace lfmemorypool {
+template <std::size_t I>
+struct LockFreePoolRegistry<PooledType<I>> {
+    static inline LockFreeMemoryPool<PooledType<I>> pool{2 * kLiveObjects};
+};
+}  // namespace lfmemorypool
+
+namespace {
+
+using AllocateFn = void* (*)(int);
+using DeallocateFn = void (*)(void*);
+
+template <std::size_t I>
+void* allocate_type(int id) {
+    return lockfree_pool_alloc_fast<PooledType<I>>(id);
+}
+
+template <std::size_t I>
+void deallocate_type(void* obj) {
+    lockfree_pool_free_fast(static_cast<PooledType<I>*>(obj));
+}
+
+template <std::size_t... I>
+constexpr std::array<AllocateFn, sizeof...(I)> make_allocate_table(std::index_sequence<I...>) {
+    return {&allocate_type<I>...};
+}
+
+template <std::size_t... I>
+constexpr std::array<DeallocateFn, sizeof...(I)> make_deallocate_table(
+    std::index_sequence<I...>) {
+    return {&deallocate_type<I>...};
+}
+
+constexpr auto kAllocate = make_allocate_table(std::make_index_sequence<kMaxTypes>{});
+constexpr auto kDeallocate = make_deallocate_table(std::make_index_sequence<kMaxTypes>{});
+
+struct Pick {
+    std::uint16_t type;
+    std::uint16_t slot;
+};
+
+}  // namespace
+
+/**
+ * @brief Replace random live objects with objects of random types out of range(0) types
+ * @ingroup benchmarks
+ */
+static void BM_ManyPoolsMixed(benchmark::State& state) {
+    const auto types = static_cast<std::size_t>(state.range(0));
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> type_dist(0, types - 1);
+    std::uniform_int_distribution<std::size_t> slot_dist(0, kLiveObjects - 1);
+    std::vector<Pick> picks(kPickSequence);
+    for (Pick& pick : picks) {
+        pick = {static_cast<std::uint16_t>(type_dist(rng)),
+                static_cast<std::uint16_t>(slot_dist(rng))};
+    }
+
+    // Live set, seeded with every type in turn
+    std::vector<void*> live(kLiveObjects);
+    std::vector<std::uint16_t> live_type(kLiveObjects);
+    for (std::size_t i = 0; i < kLiveObjects; ++i) {
+        live_type[i] = static_cast<std::uint16_t>(i % types);
+        live[i] = kAllocate[live_type[i]](static_cast<int>(i));
+    }
+
+    std::size_t next = 0;
+    bench::PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        for (std::size_t op = 0; op < kOpsPerIteration; ++op) {
+            const Pick pick = picks[next];
+            next = (next + 1) % kPickSequence;
+
+            kDeallocate[live_type[pick.slot]](live[pick.slot]);
+            live[pick.slot] = kAllocate[pick.type](static_cast<int>(op));
+            live_type[pick.slot] = pick.type;
+        }
+        benchmark::DoNotOptimize(live.data());
+    }
+    perf.stop();
+
+    for (std::size_t i = 0; i < kLiveObjects; ++i) {
+        kDeallocate[live_type[i]](live[i]);
+    }
+
+    const auto operations = state.iterations() * kOpsPerIteration;
+    perf.report(state, static_cast<double>(operations));
+    state.SetItemsProcessed(operations);
+    state.counters["pool_types"] = static_cast<double>(types);
+}
+
+BENCHMARK(BM_ManyPoolsMixed)->Arg(1)->Arg(8)->Arg(32)->Arg(64)->ArgName("types");
+
+BENCHMARK_MAIN();
@@ -0,0 +1,216 @@
+/**
+ * @file mpmc_queue_benchmark.cpp
+ * @brief LockFreeMPMCQueue against a mutex-protected std::deque and a bounded ring buffer
+ * @details P producers push kItemsPerProducer items into one shared queue while C consumers
+ * pop them. The queues compared:
+ * - LockFreeMPMCQueue: Michael-Scott queue with pool-allocated nodes (src/LockFreeMPMCQueue.h)
+ * - MutexDequeQueue: std::deque behind a std::mutex, bounded to the same capacity; the deque
+ *   allocates its chunks from the heap as it grows and shrinks
+ * - BoundedRingQueue: Vyukov's bounded MPMC ring, values stored inline in sequenced cells
+ *
+ * Reports items per second and sampled push-to-pop latency percentiles.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../src/LockFreeMPMCQueue.h"
+#include "latency_samples.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kItemsPerProducer = 1 << 15;
+constexpr std::size_t kQueueCapacity = 1024;
+constexpr std::size_t kSampleEvery = 64;
+
+/// Queued item: the push timestamp doubles as payload
+struct Item {
+    std::int64_t pushed_ns = 0;
+    std::uint64_t sequence = 0;
+};
+
+/// std::deque guarded by a std::mutex, refusing pushes beyond its capacity
+class MutexDequeQueue {
+   public:
+    explicit MutexDequeQueue(std::size_t capacity) : capacity_(capacity) {
+    }
+
+    bool try_push(const Item& item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.size() == capacity_) {
+            return false;
+        }
+        items_.push_back(item);
+        return true;
+    }
+
+    bool try_pop(Item& item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.empty()) {
+            return false;
+        }
+        item = items_.front();
+        items_.pop_front();
+        return true;
+    }
+
+   private:
+    std::mutex mutex_;
+    std::deque<Item> items_;
+    std::size_t capacity_;
+};
+
+/// Vyukov's bounded MPMC ring: each cell carries a sequence number giving its turn
+class BoundedRingQueue {
+   public:
+    explicit BoundedRingQueue(std::size_t capacity)
+        : cells_(std::make_unique<Cell[]>(capacity)), mask_(capacity - 1) {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool try_push(const Item& item) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.item = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(Item& item) {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = cell.item;
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Empty
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+   private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        Item item;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_;  // Capacity must be a power of two
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+}  // namespace
+
+/**
+ * @brief range(0) producers and range(1) consumers sharing one queue
+ * @details Threads are created outside the timed region and released together; the
+ * iteration time runs until every item has been popped. A full or empty queue makes the
+ * thread yield and retry.
+ * @ingroup benchmarks
+ */
+template <typename Queue>
+static void BM_MPMCQueue(benchmark::State& state) {
+    const auto producers = static_cast<std::size_t>(state.range(0));
+    const auto consumers = static_cast<std::size_t>(state.range(1));
+    const std::size_t total = producers * kItemsPerProducer;
+    bench::LatencySamples latency;
+
+    for (auto _ : state) {
+        auto queue = std::make_unique<Queue>(kQueueCapacity);
+        std::atomic<bool> go{false};
+        std::atomic<std::size_t> popped{0};
+        std::vector<bench::LatencySamples> samples(consumers);
+        std::vector<std::thread> threads;
+
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (std::size_t i = 0; i < kItemsPerProducer; ++i) {
+                    const Item item{i % kSampleEvery == 0 ? bench::now_ns() : 0, i};
+                    while (!queue->try_push(item)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::size_t c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c] {
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                Item item;
+                while (popped.load(std::memory_order_relaxed) < total) {
+                    if (!queue->try_pop(item)) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    if (item.pushed_ns != 0) {
+                        samples[c].add(bench::now_ns() - item.pushed_ns);
+                    }
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        state.SetIterationTime(elapsed.count());
+
+        for (const auto& local : samples) {
+            latency.merge(local);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * total);
+    latency.report(state, "push_to_pop");
+}
+
+static void QueueShapes(benchmark::internal::Benchmark* b) {
+    b->Args({1, 1})->Args({2, 2})->Args({4, 4})->Args({1, 4})->Args({4, 1});
+    b->ArgNames({"producers", "consumers"})->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(BM_MPMCQueue, LockFreeMPMCQueue<Item>)->Apply(QueueShapes);
+BENCHMARK_TEMPLATE(BM_MPMCQueue, MutexDequeQueue)->Apply(QueueShapes);
+BENCHMARK_TEMPLATE(BM_MPMCQueue, BoundedRingQueue)->Apply(QueueShapes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,121 @@
+/**
+ * @file near_full_benchmark.cpp
+ * @brief allocate_fast() latency on nearly full and exhausted pools
+ * @details The linear probe in allocate_fast() gets longer as free slots become scarce and
+ * degenerates to a full scan when the pool is exhausted. These benchmarks pre-fill a
+ * LockFreeMemoryPool<TestObject> to a target utilization, leaving a random pattern of
+ * free slots, and then measure allocation attempts at that utilization.
+ *
+ * Every successful allocation is released immediately, so the utilization stays at the
+ * target for the whole run. At 100% every attempt fails and scans the whole pool.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "benchmark_common.h"
+#include "perf_counters.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+// Shared between benchmark threads; set up and torn down by thread 0 outside the timed loop
+std::unique_ptr<LockFreeMemoryPool<TestObject>> near_full_pool;
+std::vector<TestObject*> resident_objects;
+
+void fill_pool(size_t pool_size, size_t used_slots) {
+    near_full_pool = std::make_unique<LockFreeMemoryPool<TestObject>>(pool_size);
+    resident_objects.clear();
+    for (size_t i = 0; i < pool_size; ++i) {
+        resident_objects.push_back(near_full_pool->allocate_fast(static_cast<int>(i), 0.0, "fill"));
+    }
+
+    // Punch holes at random positions (fixed seed for reproducible layouts)
+    std::mt19937 gen(42);
+    std::shuffle(resident_objects.begin(), resident_objects.end(), gen);
+    while (resident_objects.size() > used_slots) {
+        near_full_pool->deallocate_fast(resident_objects.back());
+        resident_objects.pop_back();
+    }
+}
+
+void drain_pool() {
+    for (TestObject* obj : resident_objects) {
+        near_full_pool->deallocate_fast(obj);
+    }
+    resident_objects.clear();
+    near_full_pool.reset();
+}
+
+}  // namespace
+
+/**
+ * @brief Allocation attempts against a pool held at a fixed utilization
+ * @details range(0) is the utilization in permille, range(1) the pool capacity.
+ * Reports how many attempts succeeded and failed; with 1000 permille every attempt is
+ * a failing full scan, otherwise failures only occur when threads race for the last holes.
+ * @ingroup benchmarks
+ */
+static void BM_NearFullAllocation(benchmark::State& state) {
+    const auto utilization_permille = static_cast<size_t>(state.range(0));
+    const auto pool_size = static_cast<size_t>(state.range(1));
+
+    if (state.thread_index() == 0) {
+        fill_pool(pool_size, pool_size * utilization_permille / 1000);
+    }
+
+    int64_t succeeded = 0;
+    int64_t failed = 0;
+    bench::PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        TestObject* obj = near_full_pool->allocate_fast(state.thread_index(), 1.0, "probe");
+        benchmark::DoNotOptimize(obj);
+        if (obj) {
+            ++succeeded;
+            near_full_pool->deallocate_fast(obj);
+        } else {
+            ++failed;
+        }
+    }
+    perf.stop();
+
+    if (state.thread_index() == 0) {
+        drain_pool();
+    }
+
+    perf.report(state, static_cast<double>(state.iterations()));
+    state.SetItemsProcessed(state.iterations());
+    state.counters["utilization_pct"] =
+        benchmark::Counter(utilization_permille / 10.0, benchmark::Counter::kAvgThreads);
+    state.counters["succeeded"] = static_cast<double>(succeeded);
+    state.counters["failed"] = static_cast<double>(failed);
+    state.counters["failure_ratio"] = benchmark::Counter(
+        static_cast<double>(failed) / std::max<int64_t>(succeeded + failed, 1),
+        benchmark::Counter::kAvgThreads);
+}
+
+static void NearFullArguments(benchmark::internal::Benchmark* b) {
+    for (int64_t pool_size : {4096, 65536}) {
+        for (int64_t permille : {900, 990, 1000}) {
+            b->Args({permille, pool_size});
+        }
+    }
+    b->ArgNames({"util_permille", "pool_size"});
+}
+
+BENCHMARK(BM_NearFullAllocation)
+    ->Apply(NearFullArguments)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(8)
+    ->UseRealTime()
+    ->Unit(benchmark::kNanosecond);
+
+BENCHMARK_MAIN();
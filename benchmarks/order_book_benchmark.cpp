@@ -0,0 +1,226 @@
+/**
+ * @file order_book_benchmark.cpp
+ * @brief Macro benchmark: limit order book with pooled orders
+ * @details A single-instrument limit order book processes a pregenerated stream of events:
+ * - add: a new resting order is allocated and queued at its price level;
+ * - cancel: a random resting order is unlinked and freed;
+ * - execute: an incoming marketable order consumes resting orders from the best opposite
+ *   level, freeing every order it fills completely.
+ *
+ * Price levels are a fixed array of intrusive FIFO queues and orders are found by id through
+ * a flat table, so order allocation is the only allocator traffic. The same event stream runs
+ * with the pool and with new/delete; the benchmark reports events per second and sampled
+ * per-event latency.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "allocation_strategies.h"
+#include "latency_samples.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kPriceLevels = 1024;
+constexpr std::size_t kEvents = 1 << 16;
+constexpr std::size_t kMaxResting = 1 << 14;  // Adds turn into cancels above this
+constexpr std::size_t kPoolCapacity = 2 * kMaxResting;  // Headroom: probing never saturates
+constexpr std::size_t kSampleEvery = 16;
+
+enum class Side : std::uint8_t { Buy, Sell };
+
+/// Resting limit order, linked into its price level's FIFO queue
+struct Order {
+    std::uint64_t id;
+    std::uint32_t price;
+    std::uint32_t quantity;
+    Side side;
+    Order* prev = nullptr;
+    Order* next = nullptr;
+
+    Order(std::uint64_t order_id, std::uint32_t px, std::uint32_t qty, Side s)
+        : id(order_id), price(px), quantity(qty), side(s) {
+    }
+};
+
+enum class EventType : std::uint8_t { Add, Cancel, Execute };
+
+struct Event {
+    EventType type;
+    Side side;
+    std::uint32_t price;
+    std::uint32_t quantity;
+    std::uint32_t pick;  // Random value choosing the order to cancel
+};
+
+std::vector<Event> make_events() {
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> kind(0, 99);
+    std::normal_distribution<double> offset(0.0, 12.0);
+    std::uniform_int_distribution<std::uint32_t> quantity(1, 100);
+    std::vector<Event> events(kEvents);
+    for (Event& event : events) {
+        const int roll = kind(rng);
+        event.type = roll < 55   ? EventType::Add
+                     : roll < 85 ? EventType::Cancel
+                                 : EventType::Execute;
+        event.side = rng() & 1 ? Side::Buy : Side::Sell;
+        // Buys rest below the middle of the book, sells above it
+        const double distance = 1.0 + std::abs(offset(rng));
+        const double mid = kPriceLevels / 2.0;
+        const double price = event.side == Side::Buy ? mid - distance : mid + distance;
+        event.price = static_cast<std::uint32_t>(std::clamp(price, 0.0, kPriceLevels - 1.0));
+        event.quantity = quantity(rng);
+        event.pick = static_cast<std::uint32_t>(rng());
+    }
+    return events;
+}
+
+/// FIFO of resting orders at one price
+struct Level {
+    Order* head = nullptr;
+    Order* tail = nullptr;
+};
+
+template <typename Strategy>
+class OrderBook {
+   public:
+    OrderBook() {
+        order_slot_.reserve(kEvents);
+        resting_.reserve(kMaxResting);
+    }
+
+    ~OrderBook() {
+        for (Order* order : resting_) {
+            Strategy::deallocate(order);
+        }
+    }
+
+    void apply(const Event& event) {
+        if (event.type == EventType::Add && resting_.size() < kMaxResting) {
+            add(event);
+        } else if (event.type == EventType::Execute) {
+            execute(event);
+        } else if (!resting_.empty()) {
+            cancel(resting_[event.pick % resting_.size()]);
+        }
+    }
+
+    std::uint64_t filled() const {
+        return filled_;
+    }
+
+   private:
+    void add(const Event& event) {
+        // Ids index order_slot_, so a failed allocation must not use one up
+        Order* order = Strategy::template allocate<Order>(next_id_, event.price, event.quantity,
+                                                          event.side);
+        if (!order) {
+            return;
+        }
+        ++next_id_;
+        Level& level = levels(event.side)[event.price];
+        order->prev = level.tail;
+        (level.tail ? level.tail->next : level.head) = order;
+        level.tail = order;
+        order_slot_.push_back(resting_.size());
+        resting_.push_back(order);
+    }
+
+    // Marketable order: walk the opposite side outwards from the middle, best price first
+    // (resting sells are all above the middle, resting buys below it)
+    void execute(const Event& event) {
+        const Side resting_side = event.side == Side::Buy ? Side::Sell : Side::Buy;
+        auto& book = levels(resting_side);
+        std::uint32_t remaining = event.quantity;
+        for (std::size_t step = 0; step < kPriceLevels / 2 && remaining > 0; ++step) {
+            const std::size_t price = resting_side == Side::Sell ? kPriceLevels / 2 + step
+                                                                 : kPriceLevels / 2 - 1 - step;
+            Level& level = book[price];
+            while (level.head && remaining > 0) {
+                Order* order = level.head;
+                const std::uint32_t fill = std::min(remaining, order->quantity);
+                order->quantity -= fill;
+                remaining -= fill;
+                filled_ += fill;
+                if (order->quantity == 0) {
+                    cancel(order);
+                }
+            }
+        }
+    }
+
+    void cancel(Order* order) {
+        Level& level = levels(order->side)[order->price];
+        (order->prev ? order->prev->next : level.head) = order->next;
+        (order->next ? order->next->prev : level.tail) = order->prev;
+
+        // Swap-remove from the resting list, keeping order_slot_ in sync
+        const std::size_t slot = order_slot_[order->id];
+        Order* last = resting_.back();
+        resting_[slot] = last;
+        order_slot_[last->id] = slot;
+        resting_.pop_back();
+
+        Strategy::deallocate(order);
+    }
+
+    std::array<Level, kPriceLevels>& levels(Side side) {
+        return side == Side::Buy ? bids_ : asks_;
+    }
+
+    std::array<Level, kPriceLevels> bids_{};
+    std::array<Level, kPriceLevels> asks_{};
+    std::vector<Order*> resting_;          // Resting orders, any order
+    std::vector<std::size_t> order_slot_;  // Order id -> index in resting_
+    std::uint64_t next_id_ = 0;
+    std::uint64_t filled_ = 0;
+};
+
+}  // namespace
+
+DEFINE_LOCKFREE_POOL(Order, kPoolCapacity);
+
+/**
+ * @brief Process kEvents order book events per iteration
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+static void BM_OrderBook(benchmark::State& state) {
+    static const std::vector<Event> events = make_events();
+    bench::LatencySamples latency;
+    std::uint64_t filled = 0;
+
+    for (auto _ : state) {
+        OrderBook<Strategy> book;
+        for (std::size_t i = 0; i < kEvents; ++i) {
+            if (i % kSampleEvery == 0) {
+                const std::int64_t start = bench::now_ns();
+                book.apply(events[i]);
+                latency.add(bench::now_ns() - start);
+            } else {
+                book.apply(events[i]);
+            }
+        }
+        filled += book.filled();
+    }
+
+    state.SetItemsProcessed(state.iterations() * kEvents);
+    state.counters["filled_per_iteration"] =
+        static_cast<double>(filled) / static_cast<double>(state.iterations());
+    latency.report(state, "event");
+}
+
+BENCHMARK_TEMPLATE(BM_OrderBook, bench::HeapStrategy)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_OrderBook, bench::PoolFastStrategy)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,154 @@
+#pragma once
+
+/**
+ * @file perf_counters.h
+ * @brief Hardware performance counters for the benchmark programs (Linux perf_event_open)
+ * @details Each benchmark thread opens its own set of counters for the calling thread,
+ * counts user-space events around the timed loop and reports them per allocation as
+ * Google Benchmark counters averaged across threads. Events the kernel refuses (no PMU in a
+ * VM, perf_event_paranoid too strict, unsupported cache event) are skipped; if none can be
+ * opened a single note is printed and benchmarks report only their usual numbers.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <mutex>
+#endif
+
+namespace bench {
+
+/// Per-thread hardware counters reported as `<event>_per_alloc`
+class PerfCounters {
+   public:
+#if defined(__linux__)
+    PerfCounters() {
+        constexpr auto cache_miss = [](std::uint64_t cache) {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        };
+        open_event("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open_event("branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        open_event("L1D_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D));
+        open_event("LLC_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL));
+        open_event("dTLB_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB));
+        open_event("L1I_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1I));
+        open_event("iTLB_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_ITLB));
+
+        if (events.empty()) {
+            static std::once_flag reported;
+            std::call_once(reported, [this] {
+                std::fprintf(stderr,
+                             "note: hardware perf counters unavailable (%s); check "
+                             "/proc/sys/kernel/perf_event_paranoid\n",
+                             std::strerror(open_errno));
+            });
+        }
+    }
+
+    ~PerfCounters() {
+        for (const Event& event : events) {
+            close(event.fd);
+        }
+    }
+
+    /// Reset and enable all counters (call right before the timed loop)
+    void start() noexcept {
+        for (const Event& event : events) {
+            ioctl(event.fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(event.fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    /// Disable all counters (call right after the timed loop)
+    void stop() noexcept {
+        for (const Event& event : events) {
+            ioctl(event.fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+#else
+    void start() noexcept {}
+    void stop() noexcept {}
+#endif
+
+    bool available() const noexcept {
+        return !events.empty();
+    }
+
+    /**
+     * @brief Add `<event>_per_alloc` counters to the benchmark state
+     * @param allocations Allocations performed by this thread while the counters ran
+     */
+    void report(benchmark::State& state, double allocations) const {
+        if (allocations <= 0) {
+            return;
+        }
+        for (const Event& event : events) {
+            state.counters[event.name + "_per_alloc"] =
+                benchmark::Counter(read_scaled(event) / allocations,
+                                   benchmark::Counter::kAvgThreads);
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+   private:
+    struct Event {
+        std::string name;
+        int fd;
+    };
+
+#if defined(__linux__)
+    void open_event(const char* name, std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Calling thread only, any CPU, no group
+        const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd < 0) {
+            open_errno = errno;
+            return;
+        }
+        events.push_back({name, fd});
+    }
+
+    // Counter value extrapolated over the time the event was actually scheduled on the PMU
+    static double read_scaled(const Event& event) noexcept {
+        std::uint64_t values[3] = {0, 0, 0};  // value, time_enabled, time_running
+        if (read(event.fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) ||
+            values[2] == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(values[0]) * values[1] / values[2];
+    }
+
+    int open_errno = 0;
+#else
+    static double read_scaled(const Event&) noexcept {
+        return 0.0;
+    }
+#endif
+
+    std::vector<Event> events;
+};
+
+}  // namespace bench
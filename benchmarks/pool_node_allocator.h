@@ -0,0 +1,143 @@
+#pragma once
+
+/**
+ * @file pool_node_allocator.h
+ * @brief Standard allocator that serves container nodes from LockFreeMemoryPool
+ * @details PoolNodeAllocator<T> is a stateless allocator for the standard containers:
+ * - single-object allocations (list, map and unordered_map nodes) come from one global
+ *   pool per node size and alignment, NodeBlock<Size, Align>;
+ * - small arrays (deque chunks, small bucket arrays) come from power-of-two size-class
+ *   pools, ArrayBlock<Size>, from 64 bytes up to kMaxPooledArrayBytes;
+ * - anything larger goes to operator new.
+ *
+ * The pools are registered in LockFreePoolRegistry like DEFINE_LOCKFREE_POOL types, so every
+ * container of the same node type shares one pool across threads. An exhausted pool throws
+ * std::bad_alloc, as the standard allocator would.
+ * @ingroup benchmarks
+ */
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include "../src/LockFreeMemoryPool.h"
+
+namespace bench {
+
+constexpr std::size_t kNodePoolCapacity = 1 << 19;  ///< Nodes per node-size pool
+constexpr std::size_t kArrayPoolBytes = 4 << 20;    ///< Bytes per array size-class pool
+constexpr std::size_t kMinPooledArrayBytes = 64;    ///< Smallest array size class
+constexpr std::size_t kMaxPooledArrayBytes = 1024;  ///< Largest array size class
+
+/// Storage for one container node of Size bytes (left uninitialized, like operator new)
+template <std::size_t Size, std::size_t Align>
+struct NodeBlock {
+    NodeBlock() {
+    }
+
+    alignas(Align) unsigned char bytes[Size];
+};
+
+/// Storage for one array in the Size-byte size class (left uninitialized)
+template <std::size_t Size>
+struct ArrayBlock {
+    ArrayBlock() {
+    }
+
+    alignas(alignof(std::max_align_t)) unsigned char bytes[Size];
+};
+
+}  // namespace bench
+
+// One pool per node layout and per array size class
+namespace lfmemorypool {
+template <std::size_t Size, std::size_t Align>
+struct LockFreePoolRegistry<bench::NodeBlock<Size, Align>> {
+    static inline LockFreeMemoryPool<bench::NodeBlock<Size, Align>> pool{
+        bench::kNodePoolCapacity};
+};
+
+template <std::size_t Size>
+struct LockFreePoolRegistry<bench::ArrayBlock<Size>> {
+    static inline LockFreeMemoryPool<bench::ArrayBlock<Size>> pool{
+        bench::kArrayPoolBytes / Size};
+};
+}  // namespace lfmemorypool
+
+namespace bench {
+
+namespace detail {
+template <typename Block>
+void* pool_allocate() {
+    Block* block = lfmemorypool::lockfree_pool_alloc_fast<Block>();
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+
+// Call fn with a null ArrayBlock<Class>* tag for the smallest size class holding `bytes`
+template <std::size_t Class = kMinPooledArrayBytes, typename Fn>
+decltype(auto) with_array_class(std::size_t bytes, Fn&& fn) {
+    if constexpr (Class < kMaxPooledArrayBytes) {
+        if (bytes > Class) {
+            return with_array_class<Class * 2>(bytes, static_cast<Fn&&>(fn));
+        }
+    }
+    return fn(static_cast<ArrayBlock<Class>*>(nullptr));
+}
+}  // namespace detail
+
+/**
+ * @brief Stateless std-compatible allocator backed by the global pool registry
+ * @ingroup benchmarks
+ */
+template <typename T>
+class PoolNodeAllocator {
+   public:
+    using value_type = T;
+
+    PoolNodeAllocator() noexcept = default;
+
+    template <typename U>
+    PoolNodeAllocator(const PoolNodeAllocator<U>&) noexcept {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(detail::pool_allocate<Node>());
+        }
+        if (pooled_array(n)) {
+            return static_cast<T*>(detail::with_array_class(n * sizeof(T), [](auto* tag) {
+                return detail::pool_allocate<std::remove_pointer_t<decltype(tag)>>();
+            }));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (n == 1) {
+            lfmemorypool::lockfree_pool_free_fast(reinterpret_cast<Node*>(p));
+        } else if (pooled_array(n)) {
+            detail::with_array_class(n * sizeof(T), [p](auto* tag) {
+                using Block = std::remove_pointer_t<decltype(tag)>;
+                lfmemorypool::lockfree_pool_free_fast(reinterpret_cast<Block*>(p));
+            });
+        } else {
+            ::operator delete(p, std::align_val_t{alignof(T)});
+        }
+    }
+
+    template <typename U>
+    bool operator==(const PoolNodeAllocator<U>&) const noexcept {
+        return true;
+    }
+
+   private:
+    using Node = NodeBlock<sizeof(T), alignof(T)>;
+
+    static constexpr bool pooled_array(std::size_t n) noexcept {
+        return alignof(T) <= alignof(std::max_align_t) && n * sizeof(T) <= kMaxPooledArrayBytes;
+    }
+};
+
+}  // namespace bench
@@ -0,0 +1,87 @@
+#pragma once
+
+/**
+ * @file process_memory.h
+ * @brief Process memory probes (resident set size, page faults) for the footprint benchmarks
+ * @details Linux only; other platforms report zeros.
+ * @ingroup benchmarks
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace bench {
+
+/// Current resident set size of the process in bytes
+inline std::size_t resident_bytes() {
+#if defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    std::size_t total_pages = 0;
+    std::size_t resident_pages = 0;
+    if (statm >> total_pages >> resident_pages) {
+        return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+/// Minor (soft) page faults taken by the process so far
+inline std::int64_t minor_page_faults() {
+#if defined(__linux__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_minflt;
+    }
+#endif
+    return 0;
+}
+
+/// Return free heap pages to the OS so the next measurement starts from a clean baseline
+inline void release_free_heap() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+/// Bytes the heap reserves for the live block p, including its chunk header (0 if unknown)
+inline std::size_t heap_block_bytes(void* p) {
+#if defined(__GLIBC__)
+    return malloc_usable_size(p) + sizeof(std::size_t);
+#else
+    static_cast<void>(p);
+    return 0;
+#endif
+}
+
+/// Resident memory and page faults taken between construction and sample()
+class MemoryDelta {
+   public:
+    MemoryDelta() {
+        release_free_heap();
+        start_rss = resident_bytes();
+        start_faults = minor_page_faults();
+    }
+
+    void sample() {
+        rss_bytes = static_cast<double>(resident_bytes()) - static_cast<double>(start_rss);
+        minor_faults = static_cast<double>(minor_page_faults() - start_faults);
+    }
+
+    double rss_bytes = 0;
+    double minor_faults = 0;
+
+   private:
+    std::size_t start_rss = 0;
+    std::int64_t start_faults = 0;
+};
+
+}  // namespace bench
@@ -0,0 +1,117 @@
+/**
+ * @file scalability_benchmark.cpp
+ * @brief Thread scalability sweep for LockFreeMemoryPool with CPU pinning
+ * @details Runs an allocate/free churn on one shared pool from 1 up to
+ * std::thread::hardware_concurrency() threads. Every thread count is repeated for each
+ * thread placement the machine supports (unpinned, SMT siblings, same socket, cross socket),
+ * so contention on shared cache lines can be separated from scheduler noise.
+ *
+ * The pool is compiled with LFMEMORYPOOL_ENABLE_PROBE_STATS so each run also reports
+ * compare-exchange failures and probe lengths alongside throughput.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "../src/LockFreeMemoryPoolStats.h"
+#include "benchmark_common.h"
+#include "perf_counters.h"
+#include "thread_topology.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr size_t kChurnBatch = 32;
+constexpr size_t kPoolCapacity = 1 << 16;  // Far above kChurnBatch * threads: never exhausted
+
+LockFreeMemoryPool<TestObject>& shared_pool() {
+    static LockFreeMemoryPool<TestObject> pool(kPoolCapacity);
+    return pool;
+}
+
+}  // namespace
+
+/**
+ * @brief Shared-pool churn with threads pinned according to a placement
+ * @details Each thread repeatedly allocates a small batch and frees it again, so every
+ * operation competes with the other threads for slot flags and the search hint.
+ * @ingroup benchmarks
+ */
+static void BM_ScalabilityChurn(benchmark::State& state, bench::ThreadPlacement placement,
+                                std::vector<int> cpus) {
+    const int cpu = cpus.empty() ? -1 : cpus[state.thread_index() % cpus.size()];
+    bench::ScopedThreadPin pin(cpu);
+    if (cpu >= 0 && !pin.is_pinned()) {
+        state.SkipWithError("failed to set thread affinity");
+        return;
+    }
+
+    auto& pool = shared_pool();
+    std::array<TestObject*, kChurnBatch> batch{};
+    stats::reset_thread_probe_counters();
+
+    bench::PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        for (auto& obj : batch) {
+            obj = pool.allocate_fast(state.thread_index(), 1.0, "churn");
+        }
+        benchmark::DoNotOptimize(batch.data());
+        for (TestObject* obj : batch) {
+            pool.deallocate_fast(obj);
+        }
+    }
+    perf.stop();
+
+    const auto probes = stats::thread_probe_counters();
+    const double allocations = static_cast<double>(std::max<std::uint64_t>(probes.allocations, 1));
+    perf.report(state, static_cast<double>(probes.allocations + probes.exhausted));
+    state.SetItemsProcessed(state.iterations() * kChurnBatch);
+    state.SetLabel(bench::placement_name(placement));
+    state.counters["cas_failures"] = static_cast<double>(probes.cas_failures);
+    state.counters["cas_fail_per_alloc"] =
+        benchmark::Counter(probes.cas_failures / allocations, benchmark::Counter::kAvgThreads);
+    state.counters["probes_per_alloc"] =
+        benchmark::Counter(probes.probes / allocations, benchmark::Counter::kAvgThreads);
+    state.counters["exhausted"] = static_cast<double>(probes.exhausted);
+}
+
+// Register one thread sweep per placement the machine can express
+static void RegisterScalabilityBenchmarks() {
+    const int max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const auto cpus = bench::available_cpus();
+
+    for (auto placement : {bench::ThreadPlacement::Unpinned, bench::ThreadPlacement::SmtSiblings,
+                           bench::ThreadPlacement::SameSocket,
+                           bench::ThreadPlacement::CrossSocket}) {
+        auto order = bench::placement_cpus(placement, cpus);
+        if (placement != bench::ThreadPlacement::Unpinned && order.empty()) {
+            continue;  // Placement not available on this machine
+        }
+
+        const int threads = order.empty() ? max_threads : static_cast<int>(order.size());
+        const int stride = std::max(1, threads / 16);  // Keep the sweep to ~16 points
+        benchmark::RegisterBenchmark(
+            ("BM_ScalabilityChurn/" + std::string(bench::placement_name(placement))).c_str(),
+            [placement, order](benchmark::State& state) {
+                BM_ScalabilityChurn(state, placement, order);
+            })
+            ->DenseThreadRange(1, threads, stride)
+            ->UseRealTime()
+            ->Unit(benchmark::kMicrosecond);
+    }
+}
+
+int main(int argc, char** argv) {
+    RegisterScalabilityBenchmarks();
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
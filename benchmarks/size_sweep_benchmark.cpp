@@ -0,0 +1,93 @@
+/**
+ * @file size_sweep_benchmark.cpp
+ * @brief Allocation throughput and per-object memory overhead across object sizes
+ * @details Runs the same allocate/free batch for Payload<N> from 8 bytes to 64 KB, with
+ * the pool and with new/delete. The sizes include values that are not cache-line
+ * multiples (24, 100, 200, 1000, 10000), where the pool's Segment layout and malloc's size
+ * classes round differently.
+ *
+ * Besides items and bytes per second, every run reports the memory one live object costs:
+ * `slot_bytes` (the pool's Segment) or `block_bytes` (malloc's chunk, glibc only), and the
+ * overhead of that over sizeof(Payload<N>).
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include "../src/LockFreeMemoryPool.h"
+#include "allocation_strategies.h"
+#include "benchmark_common.h"
+#include "process_memory.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kBatch = 256;  // Objects live at once; also the pool capacity per size
+
+template <typename Strategy, typename T>
+double bytes_per_object(T* obj) {
+    if constexpr (std::is_same_v<Strategy, bench::PoolFastStrategy>) {
+        static_cast<void>(obj);
+        return static_cast<double>(sizeof(SegmentOf<T>));
+    } else {
+        return static_cast<double>(bench::heap_block_bytes(obj));
+    }
+}
+
+}  // namespace
+
+// Object sizes swept, in bytes: X(N) is expanded once per size
+#define SIZE_SWEEP_SIZES(X) \
+    X(8) X(24) X(64) X(100) X(128) X(200) X(256) X(1000) X(1024) X(4096) X(10000) X(65536)
+
+#define SIZE_SWEEP_POOL(N) DEFINE_LOCKFREE_POOL(Payload<N>, kBatch);
+
+SIZE_SWEEP_SIZES(SIZE_SWEEP_POOL)
+
+/**
+ * @brief Allocate kBatch Payload<N> objects, touch them, free them
+ * @ingroup benchmarks
+ */
+template <typename Strategy, std::size_t N>
+static void BM_SizeSweep(benchmark::State& state) {
+    using Object = Payload<N>;
+    std::array<Object*, kBatch> batch{};
+    double object_cost = 0.0;
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < kBatch; ++i) {
+            batch[i] = Strategy::template allocate<Object>(static_cast<int>(i));
+        }
+        int sum = 0;
+        for (const Object* obj : batch) {
+            sum += obj->do_work();
+        }
+        benchmark::DoNotOptimize(sum);
+
+        if (object_cost == 0.0) {
+            object_cost = bytes_per_object<Strategy>(batch[0]);
+        }
+        for (Object* obj : batch) {
+            Strategy::deallocate(obj);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kBatch);
+    state.SetBytesProcessed(state.iterations() * kBatch * sizeof(Object));
+    state.counters["object_bytes"] = static_cast<double>(sizeof(Object));
+    state.counters[std::is_same_v<Strategy, bench::PoolFastStrategy> ? "slot_bytes"
+                                                                      : "block_bytes"] =
+        object_cost;
+    state.counters["overhead_pct"] = (object_cost / sizeof(Object) - 1.0) * 100.0;
+}
+
+#define SIZE_SWEEP_BENCHMARKS(N)                                 \
+    BENCHMARK_TEMPLATE(BM_SizeSweep, bench::HeapStrategy, N);     \
+    BENCHMARK_TEMPLATE(BM_SizeSweep, bench::PoolFastStrategy, N);
+
+SIZE_SWEEP_SIZES(SIZE_SWEEP_BENCHMARKS)
+
+BENCHMARK_MAIN();
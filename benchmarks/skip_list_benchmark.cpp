@@ -0,0 +1,172 @@
+/**
+ * @file skip_list_benchmark.cpp
+ * @brief LockFreeSkipList against std::map behind one std::shared_mutex, as a memtable
+ * @details Two workloads:
+ * - insert: T threads fill an empty table with kFillKeys random keys, as a memtable does
+ *   between flushes; the iteration time runs until the last insert;
+ * - range scan: threads scan random ranges of range(0) entries out of a shared table half
+ *   full of kScanKeys keys, while 10% of the operations insert or erase a random key.
+ *
+ * The skip list takes its towers from per-height pools and never locks; the baseline
+ * allocates a heap node per insert and takes a single reader-writer lock.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "../src/LockFreeSkipList.h"
+#include "benchmark_common.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::size_t kFillKeys = 1 << 17;
+constexpr std::uint64_t kScanKeys = 1 << 16;
+
+/// std::map guarded by one std::shared_mutex
+class LockedMap {
+   public:
+    explicit LockedMap(std::size_t /*capacity*/) {
+    }
+
+    bool try_emplace(std::uint64_t key, std::uint64_t value) {
+        std::unique_lock lock(mutex_);
+        return map_.try_emplace(key, value).second;
+    }
+
+    bool erase(std::uint64_t key) {
+        std::unique_lock lock(mutex_);
+        return map_.erase(key) != 0;
+    }
+
+    template <typename Fn>
+    std::size_t scan(std::uint64_t from, std::uint64_t to, Fn&& fn) const {
+        std::shared_lock lock(mutex_);
+        std::size_t visited = 0;
+        for (auto it = map_.lower_bound(from); it != map_.end() && it->first < to; ++it) {
+            fn(it->first, it->second);
+            ++visited;
+        }
+        return visited;
+    }
+
+   private:
+    mutable std::shared_mutex mutex_;
+    std::map<std::uint64_t, std::uint64_t> map_;
+};
+
+using PooledSkipList = LockFreeSkipList<std::uint64_t, std::uint64_t>;
+
+/// One table per type, shared by every scan run and half filled on first use
+template <typename Table>
+Table& shared_table() {
+    static Table table(kScanKeys);
+    static const bool filled = [] {
+        for (std::uint64_t key = 0; key < kScanKeys; key += 2) {
+            static_cast<void>(table.try_emplace(key, key));
+        }
+        return true;
+    }();
+    static_cast<void>(filled);
+    return table;
+}
+
+}  // namespace
+
+/**
+ * @brief range(0) threads fill an empty table with kFillKeys random keys
+ * @details Threads are created outside the timed region and released together.
+ * @ingroup benchmarks
+ */
+template <typename Table>
+static void BM_MemtableFill(benchmark::State& state) {
+    const auto num_threads = static_cast<std::size_t>(state.range(0));
+    const std::size_t per_thread = kFillKeys / num_threads;
+
+    for (auto _ : state) {
+        auto table = std::make_unique<Table>(kFillKeys);
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&, t] {
+                std::uint64_t rng = 0x9e3779b97f4a7c15ULL * (t + 1);
+                while (!go.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (std::size_t i = 0; i < per_thread; ++i) {
+                    const std::uint64_t key = next_random(rng);
+                    benchmark::DoNotOptimize(table->try_emplace(key, key));
+                }
+            });
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        state.SetIterationTime(elapsed.count());
+    }
+
+    state.SetItemsProcessed(state.iterations() * per_thread * num_threads);
+}
+
+/**
+ * @brief Scans of range(0) entries from random keys, with 10% inserts and erases
+ * @details Items processed count the entries visited, so scan lengths compare directly.
+ * @ingroup benchmarks
+ */
+template <typename Table>
+static void BM_RangeScan(benchmark::State& state) {
+    Table& table = shared_table<Table>();
+    const auto span = static_cast<std::uint64_t>(state.range(0)) * 2;  // Every other key present
+    std::uint64_t rng = 0x9e3779b97f4a7c15ULL * (state.thread_index() + 1);
+    std::uint64_t visited = 0;
+    std::uint64_t checksum = 0;
+
+    for (auto _ : state) {
+        const std::uint64_t r = next_random(rng);
+        const std::uint64_t key = r % kScanKeys;
+        const int roll = static_cast<int>((r >> 32) % 10);
+        if (roll == 0) {
+            benchmark::DoNotOptimize(table.try_emplace(key, key));
+        } else if (roll == 1) {
+            benchmark::DoNotOptimize(table.erase(key));
+        } else {
+            visited += table.scan(key, key + span,
+                                  [&checksum](std::uint64_t, std::uint64_t value) {
+                                      checksum += value;
+                                  });
+        }
+    }
+
+    benchmark::DoNotOptimize(checksum);
+    state.SetItemsProcessed(static_cast<std::int64_t>(visited));
+}
+
+static void FillThreads(benchmark::internal::Benchmark* b) {
+    b->Arg(1)->Arg(2)->Arg(4)->Arg(8)->ArgName("threads");
+    b->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+static void ScanShapes(benchmark::internal::Benchmark* b) {
+    b->ArgName("entries")->Arg(16)->Arg(256)->ThreadRange(1, 16)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_MemtableFill, PooledSkipList)->Apply(FillThreads);
+BENCHMARK_TEMPLATE(BM_MemtableFill, LockedMap)->Apply(FillThreads);
+BENCHMARK_TEMPLATE(BM_RangeScan, PooledSkipList)->Apply(ScanShapes);
+BENCHMARK_TEMPLATE(BM_RangeScan, LockedMap)->Apply(ScanShapes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,275 @@
+/**
+ * @file soak_benchmark.cpp
+ * @brief Long-running churn against one LockFreeMemoryPool, logging drift over time
+ * @details Worker threads run a randomized mix of single allocations, frees and bursts
+ * against a shared pool, keeping it around a target utilization, for a configurable
+ * duration. Every interval one line is logged with the interval's throughput, allocate and
+ * free latency percentiles, average probe length and compare-exchange failures per
+ * allocation, and the pool's utilization and fragmentation. Slow drift in any column shows
+ * how the search hint and the occupancy pattern age under sustained churn.
+ *
+ * This is not a Google Benchmark program: it has its own command line.
+ * @code
+ * soak_benchmark --duration=3600 --threads=8 --interval=10 [--pool-size=65536]
+ *                [--utilization=0.75] [--csv]
+ * @endcode
+ * @ingroup benchmarks
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "../src/LockFreeMemoryPoolStats.h"
+#include "benchmark_common.h"
+#include "latency_samples.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+using Object = Payload<64>;
+
+constexpr std::size_t kSampleEvery = 64;    // Time every 64th operation
+constexpr std::size_t kPublishEvery = 1024;  // Operations between publishing to the reporter
+constexpr std::size_t kMaxBurst = 64;
+
+struct SoakOptions {
+    double duration_s = 60.0;
+    double interval_s = 5.0;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t pool_size = 1 << 16;
+    double utilization = 0.75;
+    bool csv = false;
+};
+
+/// What a worker shares with the reporter, guarded by `mutex`
+struct alignas(64) WorkerReport {
+    std::mutex mutex;
+    bench::LatencySamples alloc_ns;  // Since the reporter last took them
+    bench::LatencySamples free_ns;
+    std::uint64_t operations = 0;  // Cumulative
+    stats::ProbeCounters probes{};  // Cumulative
+};
+
+bool parse_options(int argc, char** argv, SoakOptions& options) {
+    bool valid = true;
+    for (int i = 1; i < argc && valid; ++i) {
+        std::string value;
+        if (parse_option(argv[i], "--duration", value)) {
+            valid = parse_number(value, options.duration_s);
+        } else if (parse_option(argv[i], "--interval", value)) {
+            valid = parse_number(value, options.interval_s);
+        } else if (parse_option(argv[i], "--threads", value)) {
+            valid = parse_number(value, options.threads);
+        } else if (parse_option(argv[i], "--pool-size", value)) {
+            valid = parse_number(value, options.pool_size);
+        } else if (parse_option(argv[i], "--utilization", value)) {
+            valid = parse_number(value, options.utilization);
+        } else if (std::strcmp(argv[i], "--csv") == 0) {
+            options.csv = true;
+        } else {
+            valid = false;
+        }
+    }
+    if (!valid || options.threads == 0 || options.pool_size == 0 || !(options.interval_s > 0) ||
+        !(options.utilization > 0 && options.utilization < 1)) {
+        std::fprintf(stderr,
+                     "usage: %s [--duration=SECONDS] [--threads=N] [--interval=SECONDS]\n"
+                     "          [--pool-size=SLOTS] [--utilization=0..1] [--csv]\n",
+                     argv[0]);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief One worker: random allocate / free / burst mix around a share of the target
+ * @details Below its share a worker mostly allocates, above it mostly frees, so the pool
+ * hovers at the target utilization while the positions of live objects keep shuffling.
+ */
+void soak_worker(LockFreeMemoryPool<Object>& pool, WorkerReport& report, std::size_t share,
+                 unsigned seed, const std::atomic<bool>& stop) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::uniform_int_distribution<std::size_t> burst_dist(2, kMaxBurst);
+    std::vector<Object*> live;
+    live.reserve(share + kMaxBurst);
+    bench::LatencySamples alloc_ns;
+    bench::LatencySamples free_ns;
+    std::uint64_t operations = 0;
+    std::uint64_t published = 0;
+
+    const auto allocate = [&] {
+        const bool sampled = operations++ % kSampleEvery == 0;
+        const std::int64_t start = sampled ? bench::now_ns() : 0;
+        Object* obj = pool.allocate_fast(static_cast<int>(operations));
+        if (sampled) {
+            alloc_ns.add(bench::now_ns() - start);
+        }
+        if (obj) {
+            live.push_back(obj);
+        }
+    };
+    const auto free_random = [&] {
+        if (live.empty()) {
+            return;
+        }
+        std::uniform_int_distribution<std::size_t> pick(0, live.size() - 1);
+        std::swap(live[pick(rng)], live.back());
+        const bool sampled = operations++ % kSampleEvery == 0;
+        const std::int64_t start = sampled ? bench::now_ns() : 0;
+        pool.deallocate_fast(live.back());
+        if (sampled) {
+            free_ns.add(bench::now_ns() - start);
+        }
+        live.pop_back();
+    };
+
+    stats::reset_thread_probe_counters();
+    while (!stop.load(std::memory_order_relaxed)) {
+        const double fill = static_cast<double>(live.size()) / static_cast<double>(share);
+        const double roll = coin(rng);
+        if (roll < 0.02) {
+            // Burst: allocate a batch, then free as many random objects
+            const std::size_t burst = burst_dist(rng);
+            for (std::size_t i = 0; i < burst; ++i) {
+                allocate();
+            }
+            for (std::size_t i = 0; i < burst; ++i) {
+                free_random();
+            }
+        } else if (roll < 1.0 - 0.5 * fill) {
+            allocate();
+        } else {
+            free_random();
+        }
+
+        if (operations - published >= kPublishEvery) {
+            std::lock_guard<std::mutex> lock(report.mutex);
+            report.alloc_ns.merge(alloc_ns);
+            report.free_ns.merge(free_ns);
+            report.operations = operations;
+            report.probes = stats::thread_probe_counters();
+            alloc_ns.clear();
+            free_ns.clear();
+            published = operations;
+        }
+    }
+
+    for (Object* obj : live) {
+        pool.deallocate_fast(obj);
+    }
+}
+
+void print_header(bool csv) {
+    if (csv) {
+        std::printf(
+            "elapsed_s,ops_per_s,alloc_p50_ns,alloc_p99_ns,alloc_p999_ns,free_p50_ns,"
+            "free_p99_ns,probes_per_alloc,cas_fail_per_alloc,exhausted,utilization_pct,"
+            "free_runs,largest_free_run,fragmentation\n");
+    } else {
+        std::printf("%9s %12s %8s %8s %9s %8s %8s %9s %9s %9s %6s %9s %9s %6s\n", "elapsed_s",
+                    "ops/s", "alloc50", "alloc99", "alloc999", "free50", "free99", "probes",
+                    "cas_fail", "exhausted", "util%", "free_runs", "max_run", "frag");
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    SoakOptions options;
+    if (!parse_options(argc, argv, options)) {
+        return 1;
+    }
+
+    auto pool = std::make_unique<LockFreeMemoryPool<Object>>(options.pool_size);
+    const auto target = static_cast<std::size_t>(options.pool_size * options.utilization);
+    const std::size_t share = std::max<std::size_t>(1, target / options.threads);
+
+    std::atomic<bool> stop{false};
+    std::vector<std::unique_ptr<WorkerReport>> reports;
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < options.threads; ++t) {
+        reports.push_back(std::make_unique<WorkerReport>());
+        workers.emplace_back(soak_worker, std::ref(*pool), std::ref(*reports.back()), share,
+                             1000 + t, std::cref(stop));
+    }
+
+    print_header(options.csv);
+    const auto start = std::chrono::steady_clock::now();
+    const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(options.interval_s));
+    auto next_report = start + interval;
+    std::uint64_t last_operations = 0;
+    stats::ProbeCounters last_probes{};
+    auto last_time = start;
+
+    for (;;) {
+        std::this_thread::sleep_until(next_report);
+        const auto now = std::chrono::steady_clock::now();
+
+        bench::LatencySamples alloc_ns;
+        bench::LatencySamples free_ns;
+        std::uint64_t operations = 0;
+        stats::ProbeCounters probes{};
+        for (auto& report : reports) {
+            std::lock_guard<std::mutex> lock(report->mutex);
+            alloc_ns.merge(report->alloc_ns);
+            free_ns.merge(report->free_ns);
+            report->alloc_ns.clear();
+            report->free_ns.clear();
+            operations += report->operations;
+            probes.allocations += report->probes.allocations;
+            probes.exhausted += report->probes.exhausted;
+            probes.probes += report->probes.probes;
+            probes.cas_failures += report->probes.cas_failures;
+        }
+
+        const auto usage = stats::get_pool_stats(*pool);
+        const auto frag = stats::get_fragmentation_stats(*pool);
+        const double seconds = std::chrono::duration<double>(now - last_time).count();
+        const double allocations = static_cast<double>(
+            std::max<std::uint64_t>(probes.allocations - last_probes.allocations, 1));
+        const double elapsed = std::chrono::duration<double>(now - start).count();
+
+        std::printf(options.csv
+                        ? "%.1f,%.0f,%.0f,%.0f,%.0f,%.0f,%.0f,%.3f,%.4f,%llu,%.1f,%zu,%zu,%.3f\n"
+                        : "%9.1f %12.0f %8.0f %8.0f %9.0f %8.0f %8.0f %9.3f %9.4f %9llu %6.1f "
+                          "%9zu %9zu %6.3f\n",
+                    elapsed, (operations - last_operations) / seconds, alloc_ns.percentile(0.50),
+                    alloc_ns.percentile(0.99), alloc_ns.percentile(0.999),
+                    free_ns.percentile(0.50), free_ns.percentile(0.99),
+                    (probes.probes - last_probes.probes) / allocations,
+                    (probes.cas_failures - last_probes.cas_failures) / allocations,
+                    static_cast<unsigned long long>(probes.exhausted - last_probes.exhausted),
+                    usage.utilization_percent, frag.free_runs, frag.largest_free_run,
+                    frag.fragmentation);
+        std::fflush(stdout);
+
+        last_operations = operations;
+        last_probes = probes;
+        last_time = now;
+        if (elapsed >= options.duration_s) {
+            break;
+        }
+        next_report += interval;
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+/**
+ * @file spsc_ring.h
+ * @brief Bounded single-producer/single-consumer ring for handing objects between threads
+ * @ingroup benchmarks
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace bench {
+
+/**
+ * @brief Bounded wait-free SPSC ring
+ * @details One thread pushes, one thread pops. Head and tail live on separate cache lines
+ * so the two sides only share the slots they hand over.
+ * @ingroup benchmarks
+ */
+template <typename T, std::size_t Capacity>
+class SpscRing {
+   public:
+    bool try_push(const T& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots_[tail % Capacity] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = slots_[head % Capacity];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+   private:
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    alignas(64) std::array<T, Capacity> slots_{};
+};
+
+}  // namespace bench
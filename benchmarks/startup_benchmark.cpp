@@ -0,0 +1,162 @@
+/**
+ * @file startup_benchmark.cpp
+ * @brief Pool construction time, time to first allocation and committed memory
+ * @details LockFreeMemoryPool backs its slots with a std::vector<Segment>, which writes every
+ * slot at construction: the whole pool is committed before the first allocation. These
+ * benchmarks track that startup cost for large pools and for many DEFINE_LOCKFREE_POOL-style
+ * pools built back to back (as static initialization does). A lazily committed backing of the
+ * same size (calloc, served by fresh zero pages) is measured as a reference point.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+#include "../src/LockFreeMemoryPool.h"
+#include "benchmark_common.h"
+#include "process_memory.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+/// Memory baseline taken with the timer paused, since it trims the heap and reads /proc
+bench::MemoryDelta baseline_outside_timing(benchmark::State& state) {
+    state.PauseTiming();
+    bench::MemoryDelta delta;
+    state.ResumeTiming();
+    return delta;
+}
+
+void report_commit(benchmark::State& state, const bench::MemoryDelta& delta,
+                   std::size_t pool_size) {
+    state.counters["slots"] = static_cast<double>(pool_size);
+    state.counters["committed_bytes"] = delta.rss_bytes;
+    state.counters["minor_faults"] = delta.minor_faults;
+}
+
+}  // namespace
+
+/**
+ * @brief Construction of one LockFreeMemoryPool<Payload<N>> with range(0) slots
+ * @ingroup benchmarks
+ */
+template <std::size_t N>
+static void BM_PoolConstruction(benchmark::State& state) {
+    const auto pool_size = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        bench::MemoryDelta delta = baseline_outside_timing(state);
+        auto pool = std::make_unique<LockFreeMemoryPool<Payload<N>>>(pool_size);
+        benchmark::DoNotOptimize(pool.get());
+
+        state.PauseTiming();
+        delta.sample();
+        report_commit(state, delta, pool_size);
+        pool.reset();
+        state.ResumeTiming();
+    }
+}
+
+/**
+ * @brief Construction plus the first allocate_fast() on a fresh pool
+ * @ingroup benchmarks
+ */
+template <std::size_t N>
+static void BM_TimeToFirstAllocation(benchmark::State& state) {
+    const auto pool_size = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        bench::MemoryDelta delta = baseline_outside_timing(state);
+        auto pool = std::make_unique<LockFreeMemoryPool<Payload<N>>>(pool_size);
+        Payload<N>* first = pool->allocate_fast(1);
+        benchmark::DoNotOptimize(first);
+
+        state.PauseTiming();
+        delta.sample();
+        report_commit(state, delta, pool_size);
+        pool->deallocate_fast(first);
+        pool.reset();
+        state.ResumeTiming();
+    }
+}
+
+/**
+ * @brief Reference: lazily committed backing of the same size, first slot touched
+ * @details calloc() of a large block maps fresh zero pages without writing them, so only
+ * the pages actually used get committed. This is what a zero-initialized lazy backing for
+ * the pool would cost up to its first allocation.
+ * @ingroup benchmarks
+ */
+template <std::size_t N>
+static void BM_LazyBackingReference(benchmark::State& state) {
+    using Segment = SegmentOf<Payload<N>>;
+    const auto pool_size = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        bench::MemoryDelta delta = baseline_outside_timing(state);
+        void* backing = std::calloc(pool_size, sizeof(Segment));
+        if (!backing) {
+            state.SkipWithError("calloc failed");
+            return;
+        }
+        auto* first = new (backing) Payload<N>(1);
+        benchmark::DoNotOptimize(first);
+
+        state.PauseTiming();
+        delta.sample();
+        report_commit(state, delta, pool_size);
+        std::free(backing);
+        state.ResumeTiming();
+    }
+}
+
+/**
+ * @brief Constructing range(0) pools of range(1) slots each, like a binary that defines
+ * many DEFINE_LOCKFREE_POOL types pays during static initialization
+ * @ingroup benchmarks
+ */
+static void BM_ManyPoolsStartup(benchmark::State& state) {
+    using Object = Payload<64>;
+    const auto pool_count = static_cast<std::size_t>(state.range(0));
+    const auto pool_size = static_cast<std::size_t>(state.range(1));
+
+    std::vector<std::unique_ptr<LockFreeMemoryPool<Object>>> pools;
+    pools.reserve(pool_count);
+    for (auto _ : state) {
+        bench::MemoryDelta delta = baseline_outside_timing(state);
+        for (std::size_t i = 0; i < pool_count; ++i) {
+            pools.push_back(std::make_unique<LockFreeMemoryPool<Object>>(pool_size));
+        }
+        benchmark::DoNotOptimize(pools.data());
+
+        state.PauseTiming();
+        delta.sample();
+        report_commit(state, delta, pool_count * pool_size);
+        pools.clear();
+        state.ResumeTiming();
+    }
+}
+
+static void LargePoolSizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(4)->Range(1 << 16, 1 << 24)->ArgName("slots");
+    b->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+BENCHMARK_TEMPLATE(BM_PoolConstruction, 8)->Apply(LargePoolSizes);
+BENCHMARK_TEMPLATE(BM_PoolConstruction, 64)->Apply(LargePoolSizes);
+BENCHMARK_TEMPLATE(BM_TimeToFirstAllocation, 8)->Apply(LargePoolSizes);
+BENCHMARK_TEMPLATE(BM_TimeToFirstAllocation, 64)->Apply(LargePoolSizes);
+BENCHMARK_TEMPLATE(BM_LazyBackingReference, 8)->Apply(LargePoolSizes);
+BENCHMARK_TEMPLATE(BM_LazyBackingReference, 64)->Apply(LargePoolSizes);
+
+BENCHMARK(BM_ManyPoolsStartup)
+    ->ArgsProduct({{16, 64, 256}, {1000, 10000}})
+    ->ArgNames({"pools", "slots"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,352 @@
+#pragma once
+
+/**
+ * @file strategy_workloads.h
+ * @brief Allocation workloads parameterized over a compile-time allocation strategy
+ * @details Shared by google_benchmark.cpp and comparative_benchmark.cpp so every allocator
+ * runs exactly the same code. See allocation_strategies.h for the strategy concept.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "allocation_strategies.h"
+#include "benchmark_common.h"
+#include "perf_counters.h"
+
+namespace bench {
+
+/// Registration options for RegisterStrategyBenchmarks()
+struct StrategyOptions {
+    bool multithreaded = true;     ///< Also register the _2T/_4T/_8T allocation benchmarks
+    int64_t max_objects = 100000;  ///< Largest object count for the allocation benchmarks;
+                                   ///< bounded pools must hold at least this many objects
+};
+
+/**
+ * @brief Parameterized allocation benchmark
+ * @details Generic benchmark that works with any allocation strategy type.
+ * This ensures fair comparison by using identical code paths for all allocation methods.
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+void BM_ParameterizedAllocation(benchmark::State& state) {
+    const int num_objects = state.range(0);
+    const std::string name = "obj";
+    int64_t failures = 0;
+    
+    bench::PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        // Fill array with allocated objects
+        std::vector<TestObject*> objects;
+        objects.reserve(num_objects);
+        
+        for (int i = 0; i < num_objects; ++i) {
+            TestObject* obj = Strategy::template allocate<TestObject>(i, i * 1.5, name);
+            if (obj) {
+                objects.push_back(obj);
+            } else {
+                ++failures;
+            }
+        }
+        
+        // Do some work to prevent optimization
+        int sum = 0;
+        for (TestObject* obj : objects) {
+            if (obj) {
+                sum += obj->do_work();
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        
+        // Clean up all objects
+        for (TestObject* obj : objects) {
+            if (obj) {
+                Strategy::deallocate(obj);
+            }
+        }
+    }
+    
+    perf.stop();
+    perf.report(state, static_cast<double>(state.iterations()) * num_objects);
+
+    // Only successful allocations count as processed objects
+    const int64_t allocated = state.iterations() * num_objects - failures;
+    state.SetItemsProcessed(allocated);
+    
+    // Set custom counters
+    state.counters["objects_per_sec"] = benchmark::Counter(
+        allocated, benchmark::Counter::kIsRate);
+    state.counters["ns_per_object"] = benchmark::Counter(
+        allocated, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["alloc_failures"] = benchmark::Counter(
+        failures, benchmark::Counter::kAvgIterations);
+}
+
+/// Per-run state shared by the threads of BM_ParameterizedAllocationOverload
+struct OverloadRendezvous {
+    /// Runs once per phase, after every thread has arrived and before any continues
+    struct PhaseEnd {
+        OverloadRendezvous* self;
+
+        void operator()() noexcept {
+            if (self->phase_failures.exchange(0, std::memory_order_relaxed) == 0) {
+                ++self->phases_without_failure;
+            }
+        }
+    };
+
+    explicit OverloadRendezvous(int threads) : barrier(threads, PhaseEnd{this}) {
+    }
+
+    std::atomic<int64_t> phase_failures{0};  ///< Failed allocations of all threads this phase
+    int64_t phases_without_failure = 0;      ///< Only touched by PhaseEnd
+    std::barrier<PhaseEnd> barrier;
+};
+
+/**
+ * @brief Allocation benchmark that asks a bounded pool for more than it holds
+ * @details Same work as BM_ParameterizedAllocation, but every thread holds its objects
+ * until all threads have finished allocating, so the combined demand really exceeds the
+ * capacity and some allocations take the exhausted path. Waiting for the other threads is
+ * not timed. The run is flagged as an error if any iteration saw no failed allocation.
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+void BM_ParameterizedAllocationOverload(benchmark::State& state) {
+    // Replaced by thread 0 before the loop; the previous run's threads have all exited
+    static std::unique_ptr<OverloadRendezvous> rendezvous;
+    if (state.thread_index() == 0) {
+        rendezvous = std::make_unique<OverloadRendezvous>(state.threads());
+    }
+
+    const int num_objects = state.range(0);
+    const std::string name = "obj";
+    int64_t failures = 0;
+    std::vector<TestObject*> objects;
+    objects.reserve(num_objects);
+
+    bench::PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        int64_t iteration_failures = 0;
+        for (int i = 0; i < num_objects; ++i) {
+            TestObject* obj = Strategy::template allocate<TestObject>(i, i * 1.5, name);
+            if (obj) {
+                objects.push_back(obj);
+            } else {
+                ++iteration_failures;
+            }
+        }
+        failures += iteration_failures;
+
+        state.PauseTiming();
+        rendezvous->phase_failures.fetch_add(iteration_failures, std::memory_order_relaxed);
+        rendezvous->barrier.arrive_and_wait();
+        state.ResumeTiming();
+
+        int sum = 0;
+        for (TestObject* obj : objects) {
+            sum += obj->do_work();
+        }
+        benchmark::DoNotOptimize(sum);
+
+        for (TestObject* obj : objects) {
+            Strategy::deallocate(obj);
+        }
+        objects.clear();
+    }
+    perf.stop();
+
+    // The last phase completed before any thread left its barrier
+    if (state.thread_index() == 0 && rendezvous->phases_without_failure > 0) {
+        state.SkipWithError("overload did not exhaust the pool in every iteration");
+    }
+
+    perf.report(state, static_cast<double>(state.iterations()) * num_objects);
+    const int64_t allocated = state.iterations() * num_objects - failures;
+    state.SetItemsProcessed(allocated);
+    state.counters["objects_per_sec"] = benchmark::Counter(
+        allocated, benchmark::Counter::kIsRate);
+    state.counters["alloc_failures"] = benchmark::Counter(
+        failures, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * @brief Parameterized fragmentation benchmark
+ * @details Tests memory fragmentation impact with alternating allocation/deallocation patterns.
+ * Uses the same code path for all allocation strategies to ensure fair comparison.
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+void BM_ParameterizedFragmentation(benchmark::State& state) {
+    const int objects_per_cycle = 50;
+    const int cycles = state.range(0);
+    const std::string frag_name = "frag";
+    const std::string refrag_name = "refrag";
+    
+    bench::PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        std::vector<TestObject*> objects;
+        objects.reserve(objects_per_cycle);
+        
+        for (int cycle = 0; cycle < cycles; ++cycle) {
+            // Allocate many objects
+            for (int i = 0; i < objects_per_cycle; ++i) {
+                TestObject* obj = Strategy::template allocate<TestObject>(i, i * 1.5, frag_name);
+                objects.push_back(obj);
+            }
+            
+            // Free every other object (create fragmentation)
+            for (int i = 1; i < objects_per_cycle; i += 2) {
+                if (objects[i]) {
+                    Strategy::deallocate(objects[i]);
+                    objects[i] = nullptr;
+                }
+            }
+            
+            // Allocate new objects (test fragmentation handling)
+            for (int i = 1; i < objects_per_cycle; i += 2) {
+                objects[i] = Strategy::template allocate<TestObject>(i + 1000, i * 2.5, refrag_name);
+            }
+            
+            // Free all for next cycle
+            for (TestObject* obj : objects) {
+                if (obj) {
+                    Strategy::deallocate(obj);
+                }
+            }
+            objects.clear();
+        }
+    }
+    
+    perf.stop();
+    const int allocations_per_cycle = objects_per_cycle + objects_per_cycle / 2;  // fill + refill
+    perf.report(state, static_cast<double>(state.iterations()) * cycles * allocations_per_cycle);
+
+    const int total_ops = cycles * objects_per_cycle * 2; // alloc + free
+    state.SetItemsProcessed(state.iterations() * total_ops);
+    state.counters["fragmentation_cycles"] = cycles;
+}
+
+/**
+ * @brief Parameterized mixed allocation pattern benchmark
+ * @details Tests realistic allocation patterns with random allocation/deallocation timing.
+ * Uses the same code path for all allocation strategies to ensure fair comparison.
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+void BM_ParameterizedMixedPattern(benchmark::State& state) {
+    const int total_operations = state.range(0);
+    const std::string name = "mixed";
+    int64_t allocations = 0;
+    
+    bench::PerfCounters perf;
+    perf.start();
+    for (auto _ : state) {
+        std::vector<TestObject*> live_objects;
+        live_objects.reserve(1000);
+        int total_work = 0;
+        
+        // Use a fixed seed for reproducible results
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<> pattern_dis(0, 2);
+        
+        for (int i = 0; i < total_operations; ++i) {
+            int pattern = pattern_dis(gen);
+            
+            if (pattern == 0 || live_objects.empty()) {
+                // Allocate new object
+                TestObject* obj = Strategy::template allocate<TestObject>(i, i * 1.1, name);
+                ++allocations;
+                if (obj) {
+                    live_objects.push_back(obj);
+                }
+            } else if (pattern == 1 && !live_objects.empty()) {
+                // Free random object
+                size_t idx = gen() % live_objects.size();
+                Strategy::deallocate(live_objects[idx]);
+                live_objects.erase(live_objects.begin() + idx);
+            } else {
+                // Do work on random object
+                if (!live_objects.empty()) {
+                    size_t idx = gen() % live_objects.size();
+                    total_work += live_objects[idx]->do_work();
+                }
+            }
+        }
+        
+        // Clean up remaining objects
+        for (TestObject* obj : live_objects) {
+            Strategy::deallocate(obj);
+        }
+        
+        benchmark::DoNotOptimize(total_work);
+    }
+    
+    perf.stop();
+    perf.report(state, static_cast<double>(allocations));
+    state.SetItemsProcessed(state.iterations() * total_operations);
+    state.counters["operations_per_sec"] = benchmark::Counter(
+        total_operations * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+/**
+ * @brief Register the parameterized benchmarks for one allocation strategy
+ * @param name Suffix used in the benchmark names (e.g. BM_Allocation_<name>)
+ * @param options Which variants to register and how large they get
+ * @ingroup benchmarks
+ */
+template <typename Strategy>
+void RegisterStrategyBenchmarks(const std::string& name, StrategyOptions options = {}) {
+    // Basic allocation benchmarks
+    benchmark::RegisterBenchmark(("BM_Allocation_" + name).c_str(),
+                                 BM_ParameterizedAllocation<Strategy>)
+        ->Range(1000, options.max_objects)->Unit(benchmark::kMicrosecond);
+
+    // Fragmentation benchmarks
+    benchmark::RegisterBenchmark(("BM_Fragmentation_" + name).c_str(),
+                                 BM_ParameterizedFragmentation<Strategy>)
+        ->Range(100, 2000)->Unit(benchmark::kMicrosecond);
+
+    // Mixed pattern benchmarks
+    benchmark::RegisterBenchmark(("BM_MixedPattern_" + name).c_str(),
+                                 BM_ParameterizedMixedPattern<Strategy>)
+        ->Range(10000, std::max<int64_t>(10000, options.max_objects))
+        ->Unit(benchmark::kMicrosecond);
+
+    if (!options.multithreaded) {
+        return;
+    }
+
+    // Multi-threaded benchmarks. Each thread gets an equal share of max_objects, so bounded
+    // pools sized to max_objects never fail (success path only). The overload variants ask
+    // for 10% more than the share and hold everything until all threads have allocated, so
+    // a bounded pool also runs its exhausted path, which for LockFreeMemoryPool scans every
+    // slot before failing. Unbounded strategies never fail, so for them an overload run
+    // would only repeat the normal one with more objects.
+    for (int threads : {2, 4, 8}) {
+        const int64_t share = options.max_objects / threads;
+        const std::string suffix = name + "_" + std::to_string(threads) + "T";
+        benchmark::RegisterBenchmark(("BM_Allocation_" + suffix).c_str(),
+                                     BM_ParameterizedAllocation<Strategy>)
+            ->Range(std::min<int64_t>(1000, share), share)
+            ->Threads(threads)->Unit(benchmark::kMicrosecond);
+        if constexpr (is_bounded_strategy_v<Strategy>) {
+            benchmark::RegisterBenchmark(("BM_AllocationOverload_" + suffix).c_str(),
+                                         BM_ParameterizedAllocationOverload<Strategy>)
+                ->Arg(share + share / 10)->Threads(threads)->Unit(benchmark::kMicrosecond);
+        }
+    }
+}
+
+}  // namespace bench
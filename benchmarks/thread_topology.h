@@ -0,0 +1,174 @@
+#pragma once
+
+/**
+ * @file thread_topology.h
+ * @brief CPU topology discovery and thread pinning for the scalability benchmarks
+ * @details Reads the core and socket layout from Linux sysfs and builds CPU orders for
+ * the supported thread placements. On other platforms no topology is reported and
+ * pinning is a no-op, so only the unpinned placement is available.
+ * @ingroup benchmarks
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace bench {
+
+/// Location of one logical CPU in the machine topology
+struct CpuInfo {
+    int cpu;     ///< Logical CPU number as used by the scheduler
+    int core;    ///< Physical core id (unique within a socket)
+    int socket;  ///< Physical package id
+};
+
+/// How benchmark threads are distributed over the machine
+enum class ThreadPlacement {
+    Unpinned,     ///< Scheduler decides (no affinity set)
+    SmtSiblings,  ///< Fill all hardware threads of one core before moving to the next
+    SameSocket,   ///< One thread per physical core, all on the same socket
+    CrossSocket,  ///< One thread per physical core, alternating between sockets
+};
+
+inline const char* placement_name(ThreadPlacement placement) noexcept {
+    switch (placement) {
+        case ThreadPlacement::Unpinned:
+            return "Unpinned";
+        case ThreadPlacement::SmtSiblings:
+            return "SmtSiblings";
+        case ThreadPlacement::SameSocket:
+            return "SameSocket";
+        case ThreadPlacement::CrossSocket:
+            return "CrossSocket";
+    }
+    return "Unknown";
+}
+
+namespace detail {
+inline int read_topology_value(int cpu, const char* field, int fallback) {
+    std::ifstream in("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + field);
+    int value = fallback;
+    if (!(in >> value)) {
+        return fallback;
+    }
+    return value;
+}
+}  // namespace detail
+
+/// Logical CPUs this process may run on, with their core and socket ids
+inline std::vector<CpuInfo> available_cpus() {
+    std::vector<CpuInfo> cpus;
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back({cpu, detail::read_topology_value(cpu, "core_id", cpu),
+                                detail::read_topology_value(cpu, "physical_package_id", 0)});
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+/**
+ * @brief CPU order for a placement: benchmark thread i is pinned to the i-th entry
+ * @return Empty for Unpinned, or when the machine cannot express the placement
+ *         (no SMT siblings for SmtSiblings, a single socket for CrossSocket)
+ */
+inline std::vector<int> placement_cpus(ThreadPlacement placement, std::vector<CpuInfo> cpus) {
+    std::sort(cpus.begin(), cpus.end(), [](const CpuInfo& a, const CpuInfo& b) {
+        return std::tie(a.socket, a.core, a.cpu) < std::tie(b.socket, b.core, b.cpu);
+    });
+
+    // First hardware thread of every physical core, grouped per socket
+    std::map<int, std::vector<int>> cores_by_socket;
+    std::set<std::pair<int, int>> seen_cores;
+    for (const CpuInfo& info : cpus) {
+        if (seen_cores.insert({info.socket, info.core}).second) {
+            cores_by_socket[info.socket].push_back(info.cpu);
+        }
+    }
+
+    std::vector<int> order;
+    switch (placement) {
+        case ThreadPlacement::Unpinned:
+            break;
+        case ThreadPlacement::SmtSiblings:
+            if (seen_cores.size() < cpus.size()) {
+                for (const CpuInfo& info : cpus) {
+                    order.push_back(info.cpu);
+                }
+            }
+            break;
+        case ThreadPlacement::SameSocket:
+            if (!cores_by_socket.empty()) {
+                order = cores_by_socket.begin()->second;
+            }
+            break;
+        case ThreadPlacement::CrossSocket:
+            if (cores_by_socket.size() > 1) {
+                for (size_t i = 0; order.size() < seen_cores.size(); ++i) {
+                    for (const auto& [socket, cores] : cores_by_socket) {
+                        if (i < cores.size()) {
+                            order.push_back(cores[i]);
+                        }
+                    }
+                }
+            }
+            break;
+    }
+    return order;
+}
+
+/// Pins the calling thread to one CPU for its lifetime and restores the original affinity
+class ScopedThreadPin {
+   public:
+    explicit ScopedThreadPin(int cpu) noexcept {
+#if defined(__linux__)
+        if (cpu >= 0 && pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved) == 0) {
+            cpu_set_t target;
+            CPU_ZERO(&target);
+            CPU_SET(cpu, &target);
+            pinned = pthread_setaffinity_np(pthread_self(), sizeof(target), &target) == 0;
+        }
+#else
+        static_cast<void>(cpu);
+#endif
+    }
+
+    ~ScopedThreadPin() {
+#if defined(__linux__)
+        if (pinned) {
+            pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+        }
+#endif
+    }
+
+    bool is_pinned() const noexcept {
+        return pinned;
+    }
+
+    ScopedThreadPin(const ScopedThreadPin&) = delete;
+    ScopedThreadPin& operator=(const ScopedThreadPin&) = delete;
+
+   private:
+#if defined(__linux__)
+    cpu_set_t saved;
+#endif
+    bool pinned = false;
+};
+
+}  // namespace bench
@@ -0,0 +1,162 @@
+/**
+ * @file timer_wheel_benchmark.cpp
+ * @brief Timeout churn: TimerWheel against a std::multimap of heap-allocated timers
+ * @details Models connection timeouts, most of which are cancelled or re-armed before they
+ * fire. range(0) timers stay armed with random delays of up to kHorizon ticks. Each
+ * iteration cancels a random one and arms a replacement; every kOpsPerTick iterations the
+ * clock advances one tick and fires whatever is due.
+ *
+ * TimerWheel takes its timers from a pool and arms and cancels in O(1); the baseline is the
+ * usual ordered container, one heap node per timer and O(log n) per operation.
+ * @ingroup benchmarks
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+#include "../src/TimerWheel.h"
+#include "benchmark_common.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+constexpr std::uint64_t kHorizon = 10000;
+constexpr std::size_t kOpsPerTick = 16;
+
+/// TimerWheel carrying the timer's position in the benchmark's handle table
+class PooledTimers {
+   public:
+    using Handle = TimerHandle;
+
+    explicit PooledTimers(std::size_t capacity) : wheel_(capacity) {
+    }
+
+    Handle arm(std::uint64_t expiry, std::size_t position) {
+        return wheel_.arm(expiry, position);
+    }
+
+    void cancel(Handle handle) {
+        wheel_.cancel(handle);
+    }
+
+    template <typename Fn>
+    std::size_t advance(std::uint64_t now, Fn&& fn) {
+        return wheel_.advance(now, fn);
+    }
+
+    [[nodiscard]] std::uint64_t now() const {
+        return wheel_.now();
+    }
+
+    static bool valid(Handle handle) {
+        return handle.valid();
+    }
+
+    static Handle invalid() {
+        return {};
+    }
+
+   private:
+    TimerWheel<std::size_t> wheel_;
+};
+
+/// std::multimap ordered by expiry; an iterator is the handle, empty once it is spent
+class HeapTimers {
+   public:
+    using Map = std::multimap<std::uint64_t, std::size_t>;
+    // Value-initialized iterators only compare with each other, so validity is kept apart
+    using Handle = std::optional<Map::iterator>;
+
+    explicit HeapTimers(std::size_t /*capacity*/) {
+    }
+
+    Handle arm(std::uint64_t expiry, std::size_t position) {
+        return timers_.emplace(expiry, position);
+    }
+
+    void cancel(Handle handle) {
+        timers_.erase(*handle);
+    }
+
+    template <typename Fn>
+    std::size_t advance(std::uint64_t now, Fn&& fn) {
+        now_ = now;
+        std::size_t fired = 0;
+        while (!timers_.empty() && timers_.begin()->first <= now) {
+            const std::size_t position = timers_.begin()->second;
+            timers_.erase(timers_.begin());
+            fn(position);
+            ++fired;
+        }
+        return fired;
+    }
+
+    [[nodiscard]] std::uint64_t now() const {
+        return now_;
+    }
+
+    static bool valid(const Handle& handle) {
+        return handle.has_value();
+    }
+
+    static Handle invalid() {
+        return std::nullopt;
+    }
+
+   private:
+    Map timers_;
+    std::uint64_t now_ = 0;
+};
+
+}  // namespace
+
+/**
+ * @brief Cancel and re-arm random timers out of range(0) armed ones, firing as the clock moves
+ * @details Items processed count cancel + arm pairs. `fired_per_tick` is how many timers
+ * ran out before being cancelled.
+ * @ingroup benchmarks
+ */
+template <typename Timers>
+static void BM_TimerChurn(benchmark::State& state) {
+    const auto live = static_cast<std::size_t>(state.range(0));
+    // Twice the live timers: a nearly full pool pays for its linear search for free slots
+    Timers timers(2 * live);
+    std::vector<typename Timers::Handle> handles(live, Timers::invalid());
+    std::uint64_t rng = 0x9e3779b97f4a7c15ULL;
+    const auto on_fire = [&handles](std::size_t position) {
+        handles[position] = Timers::invalid();
+    };
+
+    for (std::size_t i = 0; i < live; ++i) {
+        handles[i] = timers.arm(1 + next_random(rng) % kHorizon, i);
+    }
+
+    std::size_t ops = 0;
+    std::size_t ticks = 0;
+    std::size_t fired = 0;
+    for (auto _ : state) {
+        const std::uint64_t r = next_random(rng);
+        const std::size_t position = r % live;
+        if (Timers::valid(handles[position])) {
+            timers.cancel(handles[position]);
+        }
+        handles[position] = timers.arm(timers.now() + 1 + (r >> 32) % kHorizon, position);
+        if (++ops % kOpsPerTick == 0) {
+            fired += timers.advance(timers.now() + 1, on_fire);
+            ++ticks;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["fired_per_tick"] =
+        ticks > 0 ? static_cast<double>(fired) / static_cast<double>(ticks) : 0.0;
+}
+
+BENCHMARK_TEMPLATE(BM_TimerChurn, PooledTimers)->ArgName("timers")->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_TimerChurn, HeapTimers)->ArgName("timers")->Arg(1 << 10)->Arg(1 << 16);
+
+BENCHMARK_MAIN();
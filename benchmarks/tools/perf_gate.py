@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Benchmark regression gate for the LockFreeMemoryPool benchmarks.
+
+Runs a Google Benchmark executable with a filter and several repetitions, takes the median
+time of every benchmark that ran, and compares it with a checked-in baseline JSON. Exits
+with status 1 if any benchmark is slower than its baseline by more than the tolerance (an
+entry's own "tolerance" overrides --tolerance), has no baseline entry, or if the filter
+matched nothing.
+
+    perf_gate.py --benchmark ./google_benchmark --filter '^BM_Allocation_PoolFast/4096$' \\
+                 --baseline perf_baseline.json [--tolerance 0.15] [--update]
+
+With --update the measured medians are written into the baseline instead (other entries
+are kept), which is how the baseline is regenerated for a new reference machine.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+TIME_UNIT_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def run_benchmark(executable, benchmark_filter, repetitions, min_time):
+    """Run the benchmark and return {name: median time in ns}."""
+    with tempfile.NamedTemporaryFile(suffix=".json", delete=False) as out:
+        out_path = out.name
+    try:
+        subprocess.run(
+            [
+                executable,
+                "--benchmark_filter=" + benchmark_filter,
+                "--benchmark_repetitions=%d" % repetitions,
+                "--benchmark_report_aggregates_only=true",
+                "--benchmark_min_time=%g" % min_time,
+                "--benchmark_out_format=json",
+                "--benchmark_out=" + out_path,
+            ],
+            check=True,
+            stdout=subprocess.DEVNULL,
+        )
+        with open(out_path) as f:
+            results = json.load(f)
+    finally:
+        os.unlink(out_path)
+
+    medians = {}
+    for entry in results.get("benchmarks", []):
+        if entry.get("aggregate_name") == "median":
+            scale = TIME_UNIT_NS[entry.get("time_unit", "ns")]
+            medians[entry["run_name"]] = entry["real_time"] * scale
+    return medians
+
+
+def load_baseline(path):
+    if not os.path.exists(path):
+        return {"benchmarks": {}}
+    with open(path) as f:
+        return json.load(f)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--benchmark", required=True, help="benchmark executable")
+    parser.add_argument("--filter", required=True, help="--benchmark_filter regex")
+    parser.add_argument("--baseline", required=True, help="baseline JSON file")
+    parser.add_argument("--tolerance", type=float, default=0.15,
+                        help="allowed slowdown as a fraction (default 0.15)")
+    parser.add_argument("--repetitions", type=int, default=5)
+    parser.add_argument("--min-time", type=float, default=0.2,
+                        help="--benchmark_min_time per repetition in seconds")
+    parser.add_argument("--update", action="store_true",
+                        help="write the measured medians into the baseline")
+    args = parser.parse_args()
+
+    medians = run_benchmark(args.benchmark, args.filter, args.repetitions, args.min_time)
+    if not medians:
+        print("perf_gate: filter %r matched no benchmarks" % args.filter, file=sys.stderr)
+        return 1
+
+    baseline = load_baseline(args.baseline)
+    entries = baseline.setdefault("benchmarks", {})
+
+    if args.update:
+        for name, time_ns in medians.items():
+            entries.setdefault(name, {})["real_time_ns"] = round(time_ns, 3)
+            print("baseline %-70s %14.1f ns" % (name, time_ns))
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+            f.write("\n")
+        return 0
+
+    failed = False
+    for name, time_ns in sorted(medians.items()):
+        reference = entries.get(name)
+        if reference is None:
+            print("MISSING  %s (no baseline entry; rerun with --update)" % name)
+            failed = True
+            continue
+        ratio = time_ns / reference["real_time_ns"]
+        tolerance = reference.get("tolerance", args.tolerance)
+        status = "OK"
+        if ratio > 1.0 + tolerance:
+            status = "SLOWER"
+            failed = True
+        print("%-8s %-70s %12.1f ns  baseline %12.1f ns  %+6.1f%%"
+              % (status, name, time_ns, reference["real_time_ns"], (ratio - 1.0) * 100.0))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,268 @@
+#pragma once
+
+/*
+ * ClockCache - Sharded concurrent cache with CLOCK eviction and pool-slot entries
+ *
+ * - Keys are spread over shards by hash; each shard has its own reader-writer lock, hash
+ *   index and LockFreeMemoryPool of entries, sized at construction
+ * - CLOCK (second chance) eviction: a hit only sets the entry's reference bit, so lookups run
+ *   under the shared lock; inserts into a full shard sweep the clock hand over the pool
+ *   slots, clearing reference bits, and take the first entry whose bit was already clear
+ * - Eviction reuses the victim's slot in place (key and value are assigned), so a warm cache
+ *   has a fixed footprint and never calls malloc; erase returns the slot to the pool
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+#include "LockFreeMemoryPool.h"
+
+namespace lfmemorypool {
+
+/// Concurrent fixed-size cache with CLOCK eviction over pool-allocated entries
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class ClockCache final {
+   public:
+    /// Cache of at least `capacity` entries over `shards` shards (rounded up to 2^n)
+    explicit ClockCache(std::size_t capacity, std::size_t shards = 16)
+        : shard_bits(log2_ceil(shards)) {
+        const std::size_t shard_count = std::size_t{1} << shard_bits;
+        const std::size_t per_shard = (capacity + shard_count - 1) / shard_count;
+        shard_list.reserve(shard_count);
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            shard_list.push_back(std::make_unique<Shard>(per_shard == 0 ? 1 : per_shard));
+        }
+    }
+
+    ~ClockCache() {
+        for (auto& shard : shard_list) {
+            for (std::size_t slot = 0; slot < shard->slots.size(); ++slot) {
+                if (shard->slots[slot].occupied) {
+                    shard->entries.deallocate_fast(shard->entries.from_index(slot));
+                }
+            }
+        }
+    }
+
+    /// Copy the cached value for `key` into `out` and mark it referenced; false on a miss
+    [[nodiscard]] bool get(const Key& key, Value& out) const {
+        const std::size_t hash = hash_of(key);
+        Shard& shard = shard_for(hash);
+        std::shared_lock lock(shard.mutex);
+        const std::uint32_t slot = shard.find(hash, key, key_equal);
+        if (slot == null_slot) {
+            return false;
+        }
+        std::atomic<bool>& referenced = shard.slots[slot].referenced;
+        if (!referenced.load(std::memory_order_relaxed)) {
+            referenced.store(true, std::memory_order_relaxed);  // Only write when it changes
+        }
+        out = shard.entries.from_index(slot)->value;
+        return true;
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const {
+        const std::size_t hash = hash_of(key);
+        Shard& shard = shard_for(hash);
+        std::shared_lock lock(shard.mutex);
+        return shard.find(hash, key, key_equal) != null_slot;
+    }
+
+    /// Insert or overwrite `key`; a full shard evicts an unreferenced entry and reuses its
+    /// slot. Returns true if another key was evicted.
+    template <typename V>
+    bool put(const Key& key, V&& value) {
+        const std::size_t hash = hash_of(key);
+        Shard& shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        if (const std::uint32_t slot = shard.find(hash, key, key_equal); slot != null_slot) {
+            shard.entries.from_index(slot)->value = std::forward<V>(value);
+            return false;
+        }
+
+        // Only a shard with free slots asks its pool: a full pool would probe every slot
+        if (shard.count.load(std::memory_order_relaxed) < shard.slots.size()) {
+            Entry* entry = shard.entries.allocate_fast(key, std::forward<V>(value));
+            shard.link(static_cast<std::uint32_t>(shard.entries.index_of(entry)), hash);
+            return false;
+        }
+
+        const std::uint32_t victim = shard.next_victim();
+        shard.unlink(victim);
+        Entry* entry = shard.entries.from_index(victim);
+        try {
+            entry->key = key;
+            entry->value = std::forward<V>(value);
+        } catch (...) {
+            // Half-assigned: drop the entry rather than cache a mismatched key and value
+            shard.slots[victim].occupied = false;
+            shard.entries.deallocate_fast(entry);
+            throw;
+        }
+        shard.link(victim, hash);
+        return true;
+    }
+
+    /// Remove `key`, returning its slot to the pool; false if absent
+    bool erase(const Key& key) {
+        const std::size_t hash = hash_of(key);
+        Shard& shard = shard_for(hash);
+        std::unique_lock lock(shard.mutex);
+        const std::uint32_t slot = shard.find(hash, key, key_equal);
+        if (slot == null_slot) {
+            return false;
+        }
+        shard.unlink(slot);
+        shard.slots[slot].occupied = false;
+        shard.entries.deallocate_fast(shard.entries.from_index(slot));
+        return true;
+    }
+
+    /// Number of cached entries (snapshot; sums the per-shard counts without locking)
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t total = 0;
+        for (const auto& shard : shard_list) {
+            total += shard->count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// Maximum number of cached entries
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return shard_list.size() * shard_list.front()->slots.size();
+    }
+
+    // Deleted copy & move constructors and assignment-operators
+    ClockCache(const ClockCache&) = delete;
+    ClockCache(ClockCache&&) = delete;
+    ClockCache& operator=(const ClockCache&) = delete;
+    ClockCache& operator=(ClockCache&&) = delete;
+
+   private:
+    static constexpr std::uint32_t null_slot = UINT32_MAX;
+
+    struct Entry {
+        template <typename V>
+        Entry(const Key& k, V&& v) : key(k), value(std::forward<V>(v)) {
+        }
+
+        Key key;
+        Value value;
+    };
+
+    // Per pool slot bookkeeping, kept beside the pool so it also exists for free slots
+    struct SlotInfo {
+        std::size_t hash = 0;
+        std::uint32_t next = null_slot;  // Hash chain
+        bool occupied = false;
+        std::atomic<bool> referenced{false};  // Set by hits under the shared lock
+    };
+
+    struct alignas(cache_line_size) Shard {
+        explicit Shard(std::size_t slot_count)
+            : entries(slot_count),
+              slots(slot_count),
+              bucket_mask(round_up_pow2(slot_count) - 1),
+              buckets(bucket_mask + 1, null_slot) {
+        }
+
+        std::uint32_t find(std::size_t hash, const Key& key, const KeyEqual& equal) {
+            for (std::uint32_t slot = buckets[hash & bucket_mask]; slot != null_slot;
+                 slot = slots[slot].next) {
+                if (slots[slot].hash == hash && equal(entries.from_index(slot)->key, key)) {
+                    return slot;
+                }
+            }
+            return null_slot;
+        }
+
+        void link(std::uint32_t slot, std::size_t hash) noexcept {
+            SlotInfo& info = slots[slot];
+            info.hash = hash;
+            info.occupied = true;
+            info.referenced.store(false, std::memory_order_relaxed);
+            std::uint32_t& head = buckets[hash & bucket_mask];
+            info.next = head;
+            head = slot;
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        void unlink(std::uint32_t slot) noexcept {
+            std::uint32_t* link = &buckets[slots[slot].hash & bucket_mask];
+            while (*link != slot) {
+                link = &slots[*link].next;
+            }
+            *link = slots[slot].next;
+            count.store(count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        }
+
+        // Second chance: referenced entries lose their bit and are passed over once
+        std::uint32_t next_victim() noexcept {
+            for (;;) {
+                const auto slot = static_cast<std::uint32_t>(hand);
+                hand = hand + 1 == slots.size() ? 0 : hand + 1;
+                SlotInfo& info = slots[slot];
+                if (!info.occupied) {
+                    continue;
+                }
+                if (!info.referenced.load(std::memory_order_relaxed)) {
+                    return slot;
+                }
+                info.referenced.store(false, std::memory_order_relaxed);
+            }
+        }
+
+        mutable std::shared_mutex mutex;
+        LockFreeMemoryPool<Entry> entries;
+        std::vector<SlotInfo> slots;
+        std::size_t bucket_mask;
+        std::vector<std::uint32_t> buckets;
+        std::size_t hand = 0;
+        std::atomic<std::size_t> count{0};  // Written under the exclusive lock
+    };
+
+    static std::size_t round_up_pow2(std::size_t n) noexcept {
+        std::size_t pow2 = 1;
+        while (pow2 < n) {
+            pow2 <<= 1;
+        }
+        return pow2;
+    }
+
+    static unsigned log2_ceil(std::size_t n) noexcept {
+        unsigned bits = 0;
+        while ((std::size_t{1} << bits) < n) {
+            ++bits;
+        }
+        return bits;
+    }
+
+    // Mixed as in ConcurrentHashMap; the shard takes the top bits, buckets the low ones
+    std::size_t hash_of(const Key& key) const {
+        std::uint64_t h = static_cast<std::uint64_t>(hasher(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    Shard& shard_for(std::size_t hash) const noexcept {
+        const std::size_t index =
+            shard_bits == 0 ? 0 : static_cast<std::uint64_t>(hash) >> (64 - shard_bits);
+        return *shard_list[index];
+    }
+
+    unsigned shard_bits;
+    std::vector<std::unique_ptr<Shard>> shard_list;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual key_equal;
+};
+
+}  // namespace lfmemorypool
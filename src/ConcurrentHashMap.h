@@ -0,0 +1,233 @@
+#pragma once
+
+/*
+ * ConcurrentHashMap - Lock-striped concurrent hash map with pool-allocated nodes
+ *
+ * - Separate chaining over a fixed bucket array sized at construction (load factor <= 1);
+ *   the map never rehashes, so the bucket array is the only allocation besides the pool
+ * - Entry nodes come from a LockFreeMemoryPool owned by the map: insert and erase never
+ *   call malloc, and the pool capacity bounds the number of entries
+ * - Buckets are guarded by a fixed set of reader-writer locks (stripes): lookups on
+ *   different stripes never contend, lookups on the same stripe share the lock
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+#include "LockFreeMemoryPool.h"
+
+namespace lfmemorypool {
+
+/// Concurrent hash map with striped reader-writer locks and pool-allocated entries
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class ConcurrentHashMap final {
+   public:
+    /// Map holding at most `capacity` entries, with `stripes` locks (rounded up to 2^n)
+    explicit ConcurrentHashMap(std::size_t capacity, std::size_t stripes = 64)
+        : nodes(capacity),
+          bucket_mask(round_up_pow2(capacity) - 1),
+          buckets(bucket_mask + 1),
+          stripe_mask(round_up_pow2(std::min(stripes, bucket_mask + 1)) - 1),
+          locks(stripe_mask + 1) {
+    }
+
+    ~ConcurrentHashMap() {
+        for (Node*& head : buckets) {
+            while (Node* node = head) {
+                head = node->next;
+                nodes.deallocate_fast(node);
+            }
+        }
+    }
+
+    /// Insert key -> Value(args...) unless the key exists; false if it exists or the map is full
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(const Key& key, Args&&... args) {
+        const std::size_t hash = hash_of(key);
+        std::unique_lock lock(stripe_for(hash));
+        Node*& head = bucket_for(hash);
+        if (find_in(head, hash, key)) {
+            return false;
+        }
+        Node* node = nodes.allocate_fast(hash, key, std::forward<Args>(args)...);
+        if (!node) {
+            return false;
+        }
+        link_front(head, node, hash);
+        return true;
+    }
+
+    /// Insert or overwrite; false only if the key is new and the map is full
+    template <typename V>
+    [[nodiscard]] bool insert_or_assign(const Key& key, V&& value) {
+        const std::size_t hash = hash_of(key);
+        std::unique_lock lock(stripe_for(hash));
+        Node*& head = bucket_for(hash);
+        if (Node* node = find_in(head, hash, key)) {
+            node->value = std::forward<V>(value);
+            return true;
+        }
+        Node* node = nodes.allocate_fast(hash, key, std::forward<V>(value));
+        if (!node) {
+            return false;
+        }
+        link_front(head, node, hash);
+        return true;
+    }
+
+    /// Copy the value for `key` into `out`; false if absent
+    [[nodiscard]] bool find(const Key& key, Value& out) const {
+        const std::size_t hash = hash_of(key);
+        std::shared_lock lock(stripe_for(hash));
+        if (const Node* node = find_in(bucket_for(hash), hash, key)) {
+            out = node->value;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const {
+        const std::size_t hash = hash_of(key);
+        std::shared_lock lock(stripe_for(hash));
+        return find_in(bucket_for(hash), hash, key) != nullptr;
+    }
+
+    /// Call fn(Value&) under the stripe's exclusive lock; false if absent
+    template <typename Fn>
+    bool update(const Key& key, Fn&& fn) {
+        const std::size_t hash = hash_of(key);
+        std::unique_lock lock(stripe_for(hash));
+        if (Node* node = find_in(bucket_for(hash), hash, key)) {
+            std::forward<Fn>(fn)(node->value);
+            return true;
+        }
+        return false;
+    }
+
+    /// Remove `key`, returning its node to the pool; false if absent
+    bool erase(const Key& key) {
+        const std::size_t hash = hash_of(key);
+        std::unique_lock lock(stripe_for(hash));
+        for (Node** link = &bucket_for(hash); Node* node = *link; link = &node->next) {
+            if (node->hash == hash && key_equal(node->key, key)) {
+                *link = node->next;
+                nodes.deallocate_fast(node);
+                adjust_count(hash, -1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Number of entries (snapshot; sums the per-stripe counts without locking)
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t total = 0;
+        for (const Stripe& stripe : locks) {
+            total += stripe.count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// Maximum number of entries
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return nodes.capacity();
+    }
+
+    // Deleted copy & move constructors and assignment-operators
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap(ConcurrentHashMap&&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(ConcurrentHashMap&&) = delete;
+
+   private:
+    struct Node {
+        template <typename... Args>
+        Node(std::size_t h, const Key& k, Args&&... args)
+            : hash(h), key(k), value(std::forward<Args>(args)...) {
+        }
+
+        Node* next = nullptr;
+        std::size_t hash;
+        Key key;
+        Value value;
+    };
+
+    // One lock per stripe, each on its own cache line with the stripe's entry count
+    // (written under the exclusive lock, so no shared counter line bounces between writers)
+    struct alignas(cache_line_size) Stripe {
+        mutable std::shared_mutex mutex;
+        std::atomic<std::size_t> count{0};
+    };
+
+    // Hash values are mixed before masking, so identity hashes (std::hash of integers)
+    // with patterns in their low bits still spread over all buckets and stripes
+    std::size_t hash_of(const Key& key) const {
+        std::uint64_t h = static_cast<std::uint64_t>(hasher(key));
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+    static std::size_t round_up_pow2(std::size_t n) noexcept {
+        std::size_t pow2 = 1;
+        while (pow2 < n) {
+            pow2 <<= 1;
+        }
+        return pow2;
+    }
+
+    std::shared_mutex& stripe_for(std::size_t hash) const noexcept {
+        return locks[hash & stripe_mask].mutex;
+    }
+
+    // Stripes are the low bits of the bucket index, so a bucket always maps to one stripe
+    Node*& bucket_for(std::size_t hash) noexcept {
+        return buckets[hash & bucket_mask];
+    }
+
+    Node* const& bucket_for(std::size_t hash) const noexcept {
+        return buckets[hash & bucket_mask];
+    }
+
+    // Caller holds the stripe's exclusive lock
+    void link_front(Node*& head, Node* node, std::size_t hash) noexcept {
+        node->next = head;
+        head = node;
+        adjust_count(hash, 1);
+    }
+
+    void adjust_count(std::size_t hash, std::ptrdiff_t delta) noexcept {
+        std::atomic<std::size_t>& stripe_count = locks[hash & stripe_mask].count;
+        stripe_count.store(
+            stripe_count.load(std::memory_order_relaxed) + static_cast<std::size_t>(delta),
+            std::memory_order_relaxed);
+    }
+
+    Node* find_in(Node* head, std::size_t hash, const Key& key) const {
+        for (Node* node = head; node; node = node->next) {
+            if (node->hash == hash && key_equal(node->key, key)) {
+                return node;
+            }
+        }
+        return nullptr;
+    }
+
+    LockFreeMemoryPool<Node> nodes;
+    std::size_t bucket_mask;
+    std::vector<Node*> buckets;
+    std::size_t stripe_mask;
+    std::vector<Stripe> locks;
+    [[no_unique_address]] Hash hasher;
+    [[no_unique_address]] KeyEqual key_equal;
+};
+
+}  // namespace lfmemorypool
@@ -0,0 +1,220 @@
+#pragma once
+
+/*
+ * LockFreeMPMCQueue - Bounded lock-free multi-producer/multi-consumer FIFO queue
+ *
+ * Michael-Scott queue whose nodes come from a LockFreeMemoryPool owned by the queue:
+ * - push and pop never call malloc; the queue is bounded by the pool capacity
+ * - nodes are linked by pool slot index with a version tag (ABA protection)
+ * - link words live in a queue-owned array indexed by slot, so a thread that still holds a
+ *   stale index only ever reads queue memory, never a recycled node
+ * - a node returns to the pool only after its value was taken and it stopped being the
+ *   dummy head, whichever happens last (two references per node)
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "LockFreeMemoryPool.h"
+
+namespace lfmemorypool {
+
+/// Bounded lock-free MPMC FIFO queue with pool-allocated nodes
+template <typename T>
+class LockFreeMPMCQueue final {
+    static_assert(std::is_nothrow_move_assignable_v<T> && std::is_nothrow_destructible_v<T>,
+                  "LockFreeMPMCQueue: popping must not throw once a value is unlinked");
+
+   public:
+    /// Queue holding at most `capacity` elements (one extra pool slot is the dummy head)
+    explicit LockFreeMPMCQueue(std::size_t capacity)
+        : nodes(slot_count(capacity)), links(slot_count(capacity)) {
+        Node* dummy = nodes.allocate_fast();
+        const std::uint32_t index = slot_of(dummy);
+        links[index].next.store(pack(null_index, 0), std::memory_order_relaxed);
+        links[index].refs.store(1, std::memory_order_relaxed);  // No value to take
+        head.store(pack(index, 0), std::memory_order_relaxed);
+        tail.store(pack(index, 0), std::memory_order_relaxed);
+    }
+
+    ~LockFreeMPMCQueue() {
+        // Free the dummy and every queued node, destroying the values still queued
+        std::uint32_t index = index_of(head.load(std::memory_order_relaxed));
+        for (;;) {
+            const std::uint32_t next = index_of(links[index].next.load(std::memory_order_relaxed));
+            nodes.deallocate_fast(nodes.from_index(index));
+            if (next == null_index) {
+                break;
+            }
+            value_at(next)->~T();
+            index = next;
+        }
+    }
+
+    /// Construct an element at the tail; false when the queue is full
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        Node* node = nodes.allocate_fast();
+        if (!node) {
+            return false;
+        }
+        try {
+            new (node->storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            nodes.deallocate_fast(node);
+            throw;
+        }
+
+        const std::uint32_t index = slot_of(node);
+        Link& link = links[index];
+        link.refs.store(2, std::memory_order_relaxed);  // Value not taken, not yet the dummy
+        // Bump the tag so enqueuers holding this slot's previous incarnation fail their CAS
+        const std::uint64_t old_next = link.next.load(std::memory_order_relaxed);
+        link.next.store(pack(null_index, tag_of(old_next) + 1), std::memory_order_relaxed);
+
+        for (;;) {
+            std::uint64_t last = tail.load(std::memory_order_acquire);
+            std::uint64_t next = links[index_of(last)].next.load(std::memory_order_acquire);
+            if (last != tail.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (index_of(next) != null_index) {
+                // Tail is lagging behind: help move it forward
+                tail.compare_exchange_weak(last, pack(index_of(next), tag_of(last) + 1),
+                                           std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (links[index_of(last)].next.compare_exchange_weak(
+                    next, pack(index, tag_of(next) + 1), std::memory_order_release,
+                    std::memory_order_relaxed)) {
+                tail.compare_exchange_strong(last, pack(index, tag_of(last) + 1),
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+    [[nodiscard]] bool try_push(const T& value) {
+        return try_emplace(value);
+    }
+
+    [[nodiscard]] bool try_push(T&& value) {
+        return try_emplace(std::move(value));
+    }
+
+    /// Move the front element into `out`; false when the queue is empty
+    [[nodiscard]] bool try_pop(T& out) noexcept {
+        for (;;) {
+            std::uint64_t first = head.load(std::memory_order_acquire);
+            const std::uint64_t last = tail.load(std::memory_order_acquire);
+            const std::uint64_t next = links[index_of(first)].next.load(std::memory_order_acquire);
+            if (first != head.load(std::memory_order_acquire)) {
+                continue;
+            }
+            if (index_of(first) == index_of(last)) {
+                if (index_of(next) == null_index) {
+                    return false;
+                }
+                // Tail is lagging behind: help move it forward before unlinking
+                std::uint64_t expected = last;
+                tail.compare_exchange_weak(expected, pack(index_of(next), tag_of(last) + 1),
+                                           std::memory_order_release, std::memory_order_relaxed);
+                continue;
+            }
+            if (head.compare_exchange_weak(first, pack(index_of(next), tag_of(first) + 1),
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_relaxed)) {
+                // `next` is the new dummy; only this thread takes its value
+                T* value = value_at(index_of(next));
+                out = std::move(*value);
+                value->~T();
+                release(index_of(next));   // Value taken
+                release(index_of(first));  // No longer the dummy
+                return true;
+            }
+        }
+    }
+
+    /// Snapshot: true when no element was linked at the time of the call
+    [[nodiscard]] bool empty() const noexcept {
+        const std::uint64_t first = head.load(std::memory_order_acquire);
+        return index_of(links[index_of(first)].next.load(std::memory_order_acquire)) ==
+               null_index;
+    }
+
+    /// Maximum number of queued elements
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return nodes.capacity() - 1;
+    }
+
+    // Deleted copy & move constructors and assignment-operators
+    LockFreeMPMCQueue(const LockFreeMPMCQueue&) = delete;
+    LockFreeMPMCQueue(LockFreeMPMCQueue&&) = delete;
+    LockFreeMPMCQueue& operator=(const LockFreeMPMCQueue&) = delete;
+    LockFreeMPMCQueue& operator=(LockFreeMPMCQueue&&) = delete;
+
+   private:
+    // Pooled element storage; left uninitialized until try_emplace constructs the value
+    struct Node {
+        Node() {}
+
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    // Per-slot queue state, outliving every incarnation of the slot's node
+    struct Link {
+        std::atomic<std::uint64_t> next{0};  // Tagged index of the successor
+        std::atomic<std::uint32_t> refs{0};  // Value still queued + node is the dummy
+    };
+
+    static constexpr std::uint32_t null_index = UINT32_MAX;
+
+    // Tagged index: slot index in the low 32 bits, version tag in the high 32 bits
+    static constexpr std::uint64_t pack(std::uint32_t index, std::uint64_t tag) noexcept {
+        return (tag << 32) | index;
+    }
+
+    static constexpr std::uint32_t index_of(std::uint64_t tagged) noexcept {
+        return static_cast<std::uint32_t>(tagged);
+    }
+
+    static constexpr std::uint64_t tag_of(std::uint64_t tagged) noexcept {
+        return static_cast<std::uint32_t>(tagged >> 32);
+    }
+
+    static std::size_t slot_count(std::size_t capacity) {
+        if (capacity >= null_index - 1) {
+            throw std::length_error("LockFreeMPMCQueue: capacity exceeds 32-bit slot indices");
+        }
+        return capacity + 1;
+    }
+
+    T* value_at(std::uint32_t index) noexcept {
+        return std::launder(reinterpret_cast<T*>(nodes.from_index(index)->storage));
+    }
+
+    std::uint32_t slot_of(const Node* node) const noexcept {
+        return static_cast<std::uint32_t>(nodes.index_of(node));
+    }
+
+    // Drop one reference to a node; the last one returns it to the pool
+    void release(std::uint32_t index) noexcept {
+        if (links[index].refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            nodes.deallocate_fast(nodes.from_index(index));
+        }
+    }
+
+    LockFreeMemoryPool<Node> nodes;
+    std::vector<Link> links;
+
+    alignas(cache_line_size) std::atomic<std::uint64_t> head{0};
+    alignas(cache_line_size) std::atomic<std::uint64_t> tail{0};
+};
+
+}  // namespace lfmemorypool
@@ -21,6 +21,7 @@
 #include <memory>
 #include <new>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -59,6 +60,47 @@ namespace {
     } while (0)
 #endif
 
+// Optional allocation probe instrumentation for benchmarking and diagnostics.
+// Define LFMEMORYPOOL_ENABLE_PROBE_STATS before including this header to count, per thread,
+// how many slots allocate_fast() examines and how many compare-exchange attempts fail.
+// Disabled by default so the fast path carries no extra work.
+#ifdef LFMEMORYPOOL_ENABLE_PROBE_STATS
+namespace stats {
+
+/// Per-thread allocation probe counters (read via thread_probe_counters())
+struct ProbeCounters {
+    std::uint64_t allocations = 0;   ///< Successful allocate_fast() calls
+    std::uint64_t exhausted = 0;     ///< allocate_fast() calls that found no free slot
+    std::uint64_t probes = 0;        ///< Slots examined while searching for a free slot
+    std::uint64_t cas_failures = 0;  ///< Failed compare-exchange attempts (occupied or spurious)
+};
+
+namespace detail {
+inline thread_local ProbeCounters probe_counters;
+}  // namespace detail
+
+}  // namespace stats
+
+#define LFMEMORYPOOL_PROBE_STAT(counter) (++::lfmemorypool::stats::detail::probe_counters.counter)
+#else
+#define LFMEMORYPOOL_PROBE_STAT(counter) static_cast<void>(0)
+#endif
+
+namespace detail {
+
+/// Next value of a per-thread xorshift64 stream seeded from the thread id: cheap randomness
+/// for choices like skip list tower heights and steal victims, not for anything statistical
+inline std::uint64_t thread_random() noexcept {
+    thread_local std::uint64_t state =
+        0x9e3779b97f4a7c15ULL ^ std::hash<std::thread::id>{}(std::this_thread::get_id());
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+}  // namespace detail
+
 /// Lock-free memory pool with RAII support and global pool management
 template <typename T>
 class LockFreeMemoryPool final {
@@ -121,6 +163,7 @@ class LockFreeMemoryPool final {
         // Try to find and claim a free slot using lock-free search
         for (size_t attempts = 0; attempts < pool_size; ++attempts) {
             size_t idx = (start_idx + attempts) % pool_size;
+            LFMEMORYPOOL_PROBE_STAT(probes);
 
             // Retry spurious failures for each slot (but with a reasonable limit)
             for (int retry = 0; retry < max_spurious_retries; ++retry) {
@@ -145,8 +188,10 @@ class LockFreeMemoryPool final {
                     // Update hint for next allocation (relaxed - just a performance hint)
                     search_start.store((idx + 1) % pool_size, std::memory_order_relaxed);
 
+                    LFMEMORYPOOL_PROBE_STAT(allocations);
                     return ptr;
                 }
+                LFMEMORYPOOL_PROBE_STAT(cas_failures);
 
                 // If expected is still true, it was a spurious failure - retry
                 // If expected is false, the slot is genuinely occupied - move to next slot
@@ -160,6 +205,7 @@ class LockFreeMemoryPool final {
         }
 
         // Pool is exhausted
+        LFMEMORYPOOL_PROBE_STAT(exhausted);
         return nullptr;
     }
 
@@ -176,6 +222,25 @@ class LockFreeMemoryPool final {
                   "LockFreeMemoryPool: Invalid pointer in deallocate_fast");
     }
 
+    /// Number of slots in the pool
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return segments.size();
+    }
+
+    /// Slot index of an object allocated from this pool, in [0, capacity())
+    /// The index is stable while the object is allocated, so containers built on the pool
+    /// can link objects by a 32-bit index instead of a pointer.
+    [[nodiscard]] std::size_t index_of(const T* elem) const noexcept {
+        SAFE_CALL(owns_slot(elem), "LockFreeMemoryPool: Invalid pointer in index_of");
+        return reinterpret_cast<const Segment*>(elem) - &segments[0];
+    }
+
+    /// Object in slot `index` (only meaningful while that slot is allocated)
+    [[nodiscard]] T* from_index(std::size_t index) noexcept {
+        SAFE_CALL(index < segments.size(), "LockFreeMemoryPool: Invalid index in from_index");
+        return reinterpret_cast<T*>(&segments[index].memory);
+    }
+
     // Deleted default, copy & move constructors and assignment-operators
     LockFreeMemoryPool() = delete;
     LockFreeMemoryPool(const LockFreeMemoryPool&) = delete;
@@ -202,6 +267,15 @@ class LockFreeMemoryPool final {
         return true;
     }
 
+    // Whether elem points at the start of one of this pool's slots; compared as integers,
+    // since relational operators on pointers into different objects are unspecified
+    [[nodiscard]] bool owns_slot(const T* elem) const noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(elem);
+        const auto first = reinterpret_cast<std::uintptr_t>(segments.data());
+        return address >= first && address - first < segments.size() * sizeof(Segment) &&
+               (address - first) % sizeof(Segment) == 0;
+    }
+
     std::vector<Segment> segments;
 
     // Starting index for allocation search (performance optimization)
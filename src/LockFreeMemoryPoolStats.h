@@ -5,6 +5,10 @@
  * Include this header to enable statistics collection for the memory pool.
  */
 
+#ifdef LFMEMORYPOOL_ENABLE_PROBE_STATS
+#include "LockFreeMemoryPool.h"  // ProbeCounters
+#endif
+
 namespace lfmemorypool {
 
 // Forward declarations
@@ -25,6 +29,15 @@ struct PoolStats {
     double utilization_percent;  ///< Percentage of pool utilization (0-100)
 };
 
+/// Layout of the free segments, as seen by the linear slot search
+struct FragmentationStats {
+    size_t free_objects;      ///< Number of available segments
+    size_t free_runs;         ///< Number of maximal runs of consecutive free segments
+    size_t largest_free_run;  ///< Length of the longest run of free segments
+    double mean_free_run;     ///< free_objects / free_runs (0 when the pool is full)
+    double fragmentation;     ///< 1 - largest_free_run / free_objects (0 = one contiguous run)
+};
+
 namespace detail {
 // Implementation that accesses pool internals via public accessor
 template <typename T>
@@ -44,6 +57,32 @@ PoolStats get_pool_stats_impl(const LockFreeMemoryPool<T>& pool) noexcept {
 
     return PoolStats{total, free_count, used, total > 0 ? static_cast<double>(used) / total * 100.0 : 0.0};
 }
+
+// Walk the segments once, measuring the runs of free segments (snapshot)
+template <typename T>
+FragmentationStats get_fragmentation_stats_impl(const LockFreeMemoryPool<T>& pool) noexcept {
+    size_t free_count = 0;
+    size_t runs = 0;
+    size_t largest = 0;
+    size_t current = 0;
+
+    for (const auto& segment : pool.get_segments_for_stats()) {
+        if (segment.available.load(std::memory_order_relaxed)) {
+            ++free_count;
+            if (current++ == 0) {
+                ++runs;
+            }
+            largest = current > largest ? current : largest;
+        } else {
+            current = 0;
+        }
+    }
+
+    return FragmentationStats{
+        free_count, runs, largest,
+        runs > 0 ? static_cast<double>(free_count) / runs : 0.0,
+        free_count > 0 ? 1.0 - static_cast<double>(largest) / free_count : 0.0};
+}
 }  // namespace detail
 
 /// Get pool statistics for a specific pool instance
@@ -58,6 +97,30 @@ PoolStats lockfree_pool_stats() noexcept {
     return detail::get_pool_stats_impl(LockFreePoolRegistry<T>::pool);
 }
 
+/// Get the free-segment layout of a specific pool instance
+template <typename T>
+FragmentationStats get_fragmentation_stats(const LockFreeMemoryPool<T>& pool) noexcept {
+    return detail::get_fragmentation_stats_impl(pool);
+}
+
+/// Get the free-segment layout of a type's pool (using global registry)
+template <typename T>
+FragmentationStats lockfree_pool_fragmentation() noexcept {
+    return detail::get_fragmentation_stats_impl(LockFreePoolRegistry<T>::pool);
+}
+
+#ifdef LFMEMORYPOOL_ENABLE_PROBE_STATS
+/// Snapshot of the calling thread's allocation probe counters (all pools combined)
+inline ProbeCounters thread_probe_counters() noexcept {
+    return detail::probe_counters;
+}
+
+/// Reset the calling thread's allocation probe counters to zero
+inline void reset_thread_probe_counters() noexcept {
+    detail::probe_counters = ProbeCounters{};
+}
+#endif
+
 }  // namespace stats
 
 }  // namespace lfmemorypool
@@ -0,0 +1,514 @@
+#pragma once
+
+/*
+ * LockFreeSkipList - Lock-free ordered map with per-height node pools
+ *
+ * - Lock-free insert, erase, lookup and range scan (Fraser / Herlihy-Shavit skip list):
+ *   the low bit of a link marks the node that owns it as deleted at that level
+ * - Tower heights are geometric with p = 1/4. Nodes of each height H come from their own
+ *   LockFreeMemoryPool<Tower<H>>, so a variable height never falls back to malloc; when the
+ *   pool for a height is exhausted the node takes the nearest height that still has slots
+ * - Erased nodes are retired and only returned to their pool once every operation that
+ *   could still hold a reference has finished (epoch-based reclamation)
+ */
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include "LockFreeMemoryPool.h"
+
+namespace lfmemorypool {
+
+/// Lock-free ordered map with unique keys; values are immutable once inserted
+template <typename Key, typename Value, typename Compare = std::less<Key>, int MaxHeight = 12>
+class LockFreeSkipList final {
+    static_assert(MaxHeight >= 1 && MaxHeight <= 32, "LockFreeSkipList: MaxHeight in [1, 32]");
+
+   public:
+    /// List with room for at least `capacity` entries, spread over the per-height pools
+    explicit LockFreeSkipList(std::size_t capacity) : requested_capacity(capacity) {
+        create_pools(capacity, std::make_index_sequence<MaxHeight>{});
+    }
+
+    ~LockFreeSkipList() {
+        Node* node = node_of(head[0].load(std::memory_order_relaxed));
+        while (node) {
+            Node* next = node_of(node->next[0].load(std::memory_order_relaxed));
+            free_node(node);
+            node = next;
+        }
+        for (node = retired.load(std::memory_order_relaxed); node;) {
+            Node* next = node->retired_next;
+            free_node(node);
+            node = next;
+        }
+    }
+
+    /// Insert key -> Value(args...) unless the key exists; false if it exists or the list is full
+    template <typename... Args>
+    [[nodiscard]] bool try_emplace(const Key& key, Args&&... args) {
+        // Allocated outside the critical section, which would hold back the reclamation
+        // an exhausted pool may have to wait for
+        Node* node = allocate_node(random_height(), key, std::forward<Args>(args)...);
+        if (!node) {
+            return false;
+        }
+        Guard guard(*this);
+        Link* preds[MaxHeight];
+        Node* succs[MaxHeight];
+        if (search(key, nullptr, preds, succs)) {
+            free_node(node);
+            return false;
+        }
+
+        // Publish at level 0: from here on the key is in the list
+        for (;;) {
+            for (int level = 0; level < node->height; ++level) {
+                node->next[level].store(word_of(succs[level]), std::memory_order_relaxed);
+            }
+            std::uintptr_t expected = word_of(succs[0]);
+            if (preds[0][0].compare_exchange_strong(expected, word_of(node),
+                                                    std::memory_order_acq_rel,
+                                                    std::memory_order_relaxed)) {
+                break;
+            }
+            if (search(key, nullptr, preds, succs)) {
+                free_node(node);  // Never published
+                return false;
+            }
+        }
+        count.fetch_add(1, std::memory_order_relaxed);
+
+        link_upper_levels(node, preds, succs);
+
+        // An erase that marked the tower while the upper levels were being linked may have
+        // finished its unlinking before our last link: unlink whatever is still reachable
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (is_marked(node->next[0].load(std::memory_order_relaxed))) {
+            search(key, node, preds, succs);
+        }
+        return true;
+    }
+
+    /// Remove `key`; the node returns to its pool after the grace period. False if absent.
+    bool erase(const Key& key) {
+        Guard guard(*this);
+        Link* preds[MaxHeight];
+        Node* succs[MaxHeight];
+        if (!search(key, nullptr, preds, succs)) {
+            return false;
+        }
+        Node* node = succs[0];
+
+        // Mark top-down; whoever marks level 0 owns the erase
+        for (int level = node->height - 1; level >= 1; --level) {
+            node->next[level].fetch_or(1, std::memory_order_acq_rel);
+        }
+        std::uintptr_t link = node->next[0].load(std::memory_order_relaxed);
+        do {
+            if (is_marked(link)) {
+                return false;  // Erased concurrently
+            }
+        } while (!node->next[0].compare_exchange_weak(link, link | 1, std::memory_order_acq_rel,
+                                                      std::memory_order_relaxed));
+        count.fetch_sub(1, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);  // Pairs with try_emplace
+        search(key, node, preds, succs);                      // Unlink every level
+        retire(node);
+        return true;
+    }
+
+    /// Copy the value for `key` into `out`; false if absent
+    [[nodiscard]] bool find(const Key& key, Value& out) const {
+        Guard guard(*this);
+        const Node* node = lower_bound(key);
+        if (node && !less(key, node->key)) {
+            out = node->value;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const {
+        Guard guard(*this);
+        const Node* node = lower_bound(key);
+        return node && !less(key, node->key);
+    }
+
+    /// Call fn(key, value) in key order for every entry in [from, to); returns the count
+    /// The scan is one critical section: retired nodes are not freed until it returns, and
+    /// fn must not insert into the list (an insert may wait for that reclamation).
+    template <typename Fn>
+    std::size_t scan(const Key& from, const Key& to, Fn&& fn) const {
+        Guard guard(*this);
+        std::size_t visited = 0;
+        for (const Node* node = lower_bound(from); node && less(node->key, to);) {
+            const std::uintptr_t next = node->next[0].load(std::memory_order_acquire);
+            if (!is_marked(next)) {
+                fn(node->key, node->value);
+                ++visited;
+            }
+            node = node_of(next);
+        }
+        return visited;
+    }
+
+    /// Number of entries (snapshot)
+    [[nodiscard]] std::size_t size() const noexcept {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    /// Entries the pools were sized for
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return requested_capacity;
+    }
+
+    // Deleted copy & move constructors and assignment-operators
+    LockFreeSkipList(const LockFreeSkipList&) = delete;
+    LockFreeSkipList(LockFreeSkipList&&) = delete;
+    LockFreeSkipList& operator=(const LockFreeSkipList&) = delete;
+    LockFreeSkipList& operator=(LockFreeSkipList&&) = delete;
+
+   private:
+    using Link = std::atomic<std::uintptr_t>;  // Node pointer, low bit = marked
+
+    struct Node {
+        template <typename... Args>
+        Node(Link* tower, int h, const Key& k, Args&&... args)
+            : next(tower), height(h), key(k), value(std::forward<Args>(args)...) {
+        }
+
+        Link* next;                   // next[0..height), stored in the Tower
+        Node* retired_next = nullptr;  // Retired list link
+        std::uint64_t retired_epoch = 0;
+        int height;
+        Key key;
+        Value value;
+    };
+
+    template <int H>
+    struct Tower : Node {
+        template <typename... Args>
+        explicit Tower(const Key& k, Args&&... args)
+            : Node(links, H, k, std::forward<Args>(args)...) {
+        }
+
+        Link links[H];
+    };
+
+    template <typename Sequence>
+    struct PoolSet;
+
+    template <std::size_t... I>
+    struct PoolSet<std::index_sequence<I...>> {
+        using type = std::tuple<std::unique_ptr<LockFreeMemoryPool<Tower<I + 1>>>...>;
+    };
+
+    // Epoch-based reclamation: an operation publishes the global epoch in a participant slot
+    // for its duration. The epoch advances only when every active slot shows the current
+    // one, so a node retired in epoch e is unreachable by every running operation once the
+    // epoch reaches e + 2.
+    static constexpr std::size_t max_participants = 128;  // Concurrent operations
+    static constexpr std::uint64_t idle = UINT64_MAX;
+    static constexpr unsigned collect_interval = 64;  // Retires per thread between attempts
+
+    struct alignas(cache_line_size) Participant {
+        std::atomic<std::uint64_t> epoch{idle};
+    };
+
+    class Guard {
+       public:
+        explicit Guard(const LockFreeSkipList& owner) : list(owner), slot(owner.enter()) {
+        }
+
+        ~Guard() {
+            list.participants[slot].epoch.store(idle, std::memory_order_release);
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+       private:
+        const LockFreeSkipList& list;
+        std::size_t slot;
+    };
+
+    static Node* node_of(std::uintptr_t link) noexcept {
+        return reinterpret_cast<Node*>(link & ~std::uintptr_t{1});
+    }
+
+    static std::uintptr_t word_of(const Node* node) noexcept {
+        return reinterpret_cast<std::uintptr_t>(node);
+    }
+
+    static bool is_marked(std::uintptr_t link) noexcept {
+        return (link & 1) != 0;
+    }
+
+    bool less(const Key& a, const Key& b) const {
+        return compare(a, b);
+    }
+
+    // Pool slots per height: the expected share of nodes plus 25% headroom for variance and
+    // for retired nodes waiting out their grace period
+    template <std::size_t... I>
+    void create_pools(std::size_t capacity, std::index_sequence<I...>) {
+        const auto slots = [capacity](int height) {
+            const double share = height == MaxHeight
+                                     ? std::pow(0.25, MaxHeight - 1)
+                                     : 0.75 * std::pow(0.25, height - 1);
+            return static_cast<std::size_t>(std::ceil(capacity * share * 1.25)) + 2;
+        };
+        ((std::get<I>(pools) = std::make_unique<LockFreeMemoryPool<Tower<I + 1>>>(
+              slots(static_cast<int>(I) + 1))),
+         ...);
+    }
+
+    static int random_height() noexcept {
+        int height = 1;
+        std::uint64_t bits = detail::thread_random();
+        for (; height < MaxHeight && (bits & 3) == 0; bits >>= 2) {
+            ++height;
+        }
+        return height;
+    }
+
+    template <typename... Args>
+    Node* allocate_from(int height, const Key& key, Args&&... args) {
+        return allocate_from(height, std::make_index_sequence<MaxHeight>{}, key,
+                             std::forward<Args>(args)...);
+    }
+
+    template <std::size_t... I, typename... Args>
+    Node* allocate_from(int height, std::index_sequence<I...>, const Key& key, Args&&... args) {
+        Node* node = nullptr;
+        static_cast<void>(((height == static_cast<int>(I) + 1 &&
+                            (node = std::get<I>(pools)->allocate_fast(
+                                 key, std::forward<Args>(args)...),
+                             true)) ||
+                           ...));
+        return node;
+    }
+
+    // Preferred height first, then lower ones, then higher ones. With every pool exhausted,
+    // waits for retired nodes to come back; fails only when none are pending.
+    template <typename... Args>
+    Node* allocate_node(int preferred, const Key& key, Args&&... args) {
+        for (;;) {
+            for (int height = preferred; height >= 1; --height) {
+                if (Node* node = allocate_from(height, key, std::forward<Args>(args)...)) {
+                    return node;
+                }
+            }
+            for (int height = preferred + 1; height <= MaxHeight; ++height) {
+                if (Node* node = allocate_from(height, key, std::forward<Args>(args)...)) {
+                    return node;
+                }
+            }
+            if (retired_count.load(std::memory_order_acquire) == 0) {
+                return nullptr;
+            }
+            try_advance();
+            std::this_thread::yield();
+        }
+    }
+
+    void free_node(Node* node) noexcept {
+        free_node(node, std::make_index_sequence<MaxHeight>{});
+    }
+
+    template <std::size_t... I>
+    void free_node(Node* node, std::index_sequence<I...>) noexcept {
+        static_cast<void>(((node->height == static_cast<int>(I) + 1 &&
+                            (std::get<I>(pools)->deallocate_fast(static_cast<Tower<I + 1>*>(node)),
+                             true)) ||
+                           ...));
+    }
+
+    // Find the position of `key`: at every level, preds[level][level] is the link holding
+    // succs[level], the first node not before `key`. Marked nodes on the way are unlinked.
+    // With a `target`, equal keys other than target are passed too, so that all levels of
+    // that particular node get unlinked. Returns whether succs[0] has an equal key.
+    bool search(const Key& key, const Node* target, Link** preds, Node** succs) const {
+        for (;;) {
+            if (search_once(key, target, preds, succs)) {
+                return succs[0] && !less(key, succs[0]->key);
+            }
+        }
+    }
+
+    bool search_once(const Key& key, const Node* target, Link** preds, Node** succs) const {
+        Link* pred = head;
+        for (int level = MaxHeight - 1; level >= 0; --level) {
+            Node* curr = node_of(pred[level].load(std::memory_order_acquire));
+            while (curr) {
+                const std::uintptr_t succ = curr->next[level].load(std::memory_order_acquire);
+                if (is_marked(succ)) {
+                    std::uintptr_t expected = word_of(curr);
+                    if (!pred[level].compare_exchange_strong(expected, succ & ~std::uintptr_t{1},
+                                                             std::memory_order_acq_rel,
+                                                             std::memory_order_relaxed)) {
+                        return false;  // pred changed or got marked: start over
+                    }
+                    curr = node_of(succ);
+                    continue;
+                }
+                const bool before = less(curr->key, key) ||
+                                    (target && curr != target && !less(key, curr->key));
+                if (!before) {
+                    break;
+                }
+                pred = curr->next;
+                curr = node_of(succ);
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return true;
+    }
+
+    void link_upper_levels(Node* node, Link** preds, Node** succs) {
+        for (int level = 1; level < node->height; ++level) {
+            for (;;) {
+                std::uintptr_t expected = word_of(succs[level]);
+                if (preds[level][level].compare_exchange_strong(expected, word_of(node),
+                                                                std::memory_order_acq_rel,
+                                                                std::memory_order_relaxed)) {
+                    break;
+                }
+                // Lost a race at this level: find the new position, stop if erased meanwhile
+                if (!search(node->key, nullptr, preds, succs) || succs[0] != node) {
+                    return;
+                }
+                std::uintptr_t current = node->next[level].load(std::memory_order_acquire);
+                if (is_marked(current) ||
+                    !node->next[level].compare_exchange_strong(current, word_of(succs[level]),
+                                                               std::memory_order_acq_rel,
+                                                               std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    // First unmarked node not before `key`, without unlinking anything
+    const Node* lower_bound(const Key& key) const {
+        const Link* pred = head;
+        const Node* curr = nullptr;
+        for (int level = MaxHeight - 1; level >= 0; --level) {
+            curr = node_of(pred[level].load(std::memory_order_acquire));
+            while (curr) {
+                const std::uintptr_t succ = curr->next[level].load(std::memory_order_acquire);
+                if (is_marked(succ) || less(curr->key, key)) {
+                    if (!is_marked(succ)) {
+                        pred = curr->next;
+                    }
+                    curr = node_of(succ);
+                } else {
+                    break;
+                }
+            }
+        }
+        return curr;
+    }
+
+    std::size_t enter() const noexcept {
+        thread_local std::size_t hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+        for (;;) {
+            for (std::size_t i = 0; i < max_participants; ++i) {
+                const std::size_t slot = (hint + i) % max_participants;
+                std::uint64_t epoch = global_epoch.load(std::memory_order_seq_cst);
+                std::uint64_t expected = idle;
+                if (!participants[slot].epoch.compare_exchange_strong(
+                        expected, epoch, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    continue;
+                }
+                // Republish until stable, so we have seen the latest advance
+                for (std::uint64_t current;
+                     (current = global_epoch.load(std::memory_order_seq_cst)) != epoch;
+                     epoch = current) {
+                    participants[slot].epoch.store(current, std::memory_order_seq_cst);
+                }
+                hint = slot;
+                return slot;
+            }
+            std::this_thread::yield();  // More concurrent operations than participant slots
+        }
+    }
+
+    void retire(Node* node) noexcept {
+        node->retired_epoch = global_epoch.load(std::memory_order_seq_cst);
+        retired_count.fetch_add(1, std::memory_order_relaxed);
+        push_retired(node, node);
+        thread_local unsigned retires = 0;
+        if (++retires % collect_interval == 0) {
+            try_advance();
+        }
+    }
+
+    void push_retired(Node* first, Node* last) noexcept {
+        Node* top = retired.load(std::memory_order_relaxed);
+        do {
+            last->retired_next = top;
+        } while (!retired.compare_exchange_weak(top, first, std::memory_order_release,
+                                                std::memory_order_relaxed));
+    }
+
+    // Advance the epoch if every active operation has seen the current one, then free the
+    // nodes retired at least two epochs before the new one
+    void try_advance() noexcept {
+        std::uint64_t epoch = global_epoch.load(std::memory_order_seq_cst);
+        for (const Participant& participant : participants) {
+            const std::uint64_t seen = participant.epoch.load(std::memory_order_seq_cst);
+            if (seen != idle && seen != epoch) {
+                return;
+            }
+        }
+        if (!global_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst)) {
+            return;
+        }
+
+        Node* node = retired.exchange(nullptr, std::memory_order_acquire);
+        Node* keep_first = nullptr;
+        Node* keep_last = nullptr;
+        std::size_t freed = 0;
+        while (node) {
+            Node* next = node->retired_next;
+            if (node->retired_epoch + 2 <= epoch + 1) {
+                free_node(node);
+                ++freed;
+            } else {
+                node->retired_next = keep_first;
+                keep_first = node;
+                if (!keep_last) {
+                    keep_last = node;
+                }
+            }
+            node = next;
+        }
+        if (keep_first) {
+            push_retired(keep_first, keep_last);
+        }
+        retired_count.fetch_sub(freed, std::memory_order_release);
+    }
+
+    typename PoolSet<std::make_index_sequence<MaxHeight>>::type pools;
+    std::size_t requested_capacity;
+    [[no_unique_address]] Compare compare;
+    mutable Link head[MaxHeight]{};
+
+    alignas(cache_line_size) std::atomic<std::size_t> count{0};
+    alignas(cache_line_size) std::atomic<Node*> retired{nullptr};
+    std::atomic<std::size_t> retired_count{0};
+    alignas(cache_line_size) std::atomic<std::uint64_t> global_epoch{0};
+    mutable Participant participants[max_participants];
+};
+
+}  // namespace lfmemorypool
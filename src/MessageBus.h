@@ -0,0 +1,316 @@
+#pragma once
+
+/*
+ * MessageBus - Lock-free publish/subscribe fan-out with refcounted pooled messages
+ *
+ * - A published message is constructed once in a slot of a LockFreeMemoryPool owned by the
+ *   bus; the slot carries the reference count, so fan-out never copies the payload and
+ *   never calls malloc
+ * - Every subscriber owns a bounded single-producer/single-consumer ring of slot pointers;
+ *   publishing pushes one pointer per subscriber and costs a single atomic RMW on the
+ *   reference count, however many subscribers it reaches
+ * - A subscriber receives messages as Handles; the slot goes back to the pool when the
+ *   last Handle to it is released
+ * - A subscriber whose ring is full misses the message (counted in dropped()); when the
+ *   message pool is exhausted, try_publish() fails and nobody receives it
+ *
+ * One thread publishes; each subscriber polls from one thread at a time. Subscribing and
+ * unsubscribing are lock-free and may happen while messages are being published.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "LockFreeMemoryPool.h"
+
+namespace lfmemorypool {
+
+/// Single-publisher fan-out bus delivering pooled, refcounted T messages
+template <typename T>
+class MessageBus final {
+    struct Slot;
+
+   public:
+    /// Returned by subscribe() when every subscriber slot is taken
+    static constexpr std::size_t no_subscriber = SIZE_MAX;
+
+    /// Counted reference to a published message; releases it on destruction
+    class Handle final {
+       public:
+        Handle() noexcept = default;
+
+        Handle(const Handle& other) noexcept : bus(other.bus), slot(other.slot) {
+            if (slot) {
+                slot->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        Handle(Handle&& other) noexcept
+            : bus(std::exchange(other.bus, nullptr)), slot(std::exchange(other.slot, nullptr)) {
+        }
+
+        Handle& operator=(Handle other) noexcept {
+            std::swap(bus, other.bus);
+            std::swap(slot, other.slot);
+            return *this;
+        }
+
+        ~Handle() {
+            reset();
+        }
+
+        /// Drop this reference; the last one returns the message slot to the pool
+        void reset() noexcept {
+            if (slot) {
+                bus->release(slot, 1);
+                bus = nullptr;
+                slot = nullptr;
+            }
+        }
+
+        [[nodiscard]] const T& operator*() const noexcept {
+            return slot->value;
+        }
+
+        [[nodiscard]] const T* operator->() const noexcept {
+            return &slot->value;
+        }
+
+        explicit operator bool() const noexcept {
+            return slot != nullptr;
+        }
+
+       private:
+        friend class MessageBus;
+
+        Handle(MessageBus* owner, Slot* message) noexcept : bus(owner), slot(message) {
+        }
+
+        MessageBus* bus = nullptr;
+        Slot* slot = nullptr;
+    };
+
+    /// Bus holding at most `message_capacity` live messages, for up to `max_subscribers`
+    /// subscribers with rings of `queue_capacity` messages (rounded up to a power of two)
+    explicit MessageBus(std::size_t message_capacity, std::size_t queue_capacity = 1024,
+                        std::size_t max_subscribers = 64)
+        : messages(message_capacity), subscribers(max_subscribers) {
+        if (max_subscribers == 0 || max_subscribers >= UINT32_MAX) {
+            throw std::invalid_argument("MessageBus: max_subscribers out of range");
+        }
+        const std::size_t ring_size = std::bit_ceil(std::max<std::size_t>(queue_capacity, 1));
+        for (auto& subscriber : subscribers) {
+            subscriber = std::make_unique<Subscriber>(ring_size);
+        }
+    }
+
+    /// Releases every message still queued; no Handle may outlive the bus
+    ~MessageBus() {
+        for (auto& subscriber : subscribers) {
+            drain(*subscriber);
+        }
+    }
+
+    /// Claim a subscriber slot; no_subscriber when all are taken
+    [[nodiscard]] std::size_t subscribe() noexcept {
+        for (std::size_t i = 0; i < subscribers.size(); ++i) {
+            std::uint8_t expected = free_state;
+            if (subscribers[i]->state.compare_exchange_strong(expected, active_state,
+                                                              std::memory_order_acq_rel)) {
+                std::size_t limit = active_limit.load(std::memory_order_relaxed);
+                while (limit <= i && !active_limit.compare_exchange_weak(
+                                         limit, i + 1, std::memory_order_release)) {
+                }
+                return i;
+            }
+        }
+        return no_subscriber;
+    }
+
+    /// Stop receiving; called from the subscriber's polling thread. Messages published
+    /// concurrently are released by the publisher on its next try_publish()
+    void unsubscribe(std::size_t subscriber) noexcept {
+        Subscriber& sub = *subscribers[subscriber];
+        drain(sub);
+        // Only the publisher turns closing back into free, after draining the ring again
+        sub.state.store(closing_state, std::memory_order_release);
+    }
+
+    /// Construct a message and deliver it to every subscriber; false (and no delivery)
+    /// when the message pool is exhausted. Only one thread may publish.
+    template <typename... Args>
+    [[nodiscard]] bool try_publish(Args&&... args) {
+        Slot* slot = messages.allocate_fast(std::in_place, std::forward<Args>(args)...);
+        if (!slot) {
+            // Rings of unsubscribed readers may be what holds the pool; a failed allocation
+            // constructed nothing, so the arguments can be forwarded again
+            if (!reclaim_closed()) {
+                return false;
+            }
+            slot = messages.allocate_fast(std::in_place, std::forward<Args>(args)...);
+            if (!slot) {
+                return false;
+            }
+        }
+
+        // The bias keeps the count above zero while subscribers release concurrently;
+        // it exceeds the number of rings the message can reach
+        const std::uint32_t bias = static_cast<std::uint32_t>(subscribers.size()) + 1;
+        slot->refs.store(bias, std::memory_order_relaxed);
+
+        std::uint32_t delivered = 0;
+        const std::size_t limit = active_limit.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < limit; ++i) {
+            Subscriber& sub = *subscribers[i];
+            const std::uint8_t state = sub.state.load(std::memory_order_acquire);
+            if (state == active_state) {
+                if (sub.push(slot)) {
+                    ++delivered;
+                } else {
+                    sub.dropped.store(sub.dropped.load(std::memory_order_relaxed) + 1,
+                                      std::memory_order_relaxed);
+                }
+            } else if (state == closing_state) {
+                reclaim(sub);
+            }
+        }
+        release(slot, bias - delivered);
+        return true;
+    }
+
+    /// Take the subscriber's oldest message; false when its ring is empty
+    [[nodiscard]] bool poll(std::size_t subscriber, Handle& out) noexcept {
+        Slot* slot = subscribers[subscriber]->pop();
+        if (!slot) {
+            return false;
+        }
+        out = Handle(this, slot);
+        return true;
+    }
+
+    /// Messages the subscriber missed because its ring was full
+    [[nodiscard]] std::uint64_t dropped(std::size_t subscriber) const noexcept {
+        return subscribers[subscriber]->dropped.load(std::memory_order_relaxed);
+    }
+
+    /// Maximum number of live messages
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return messages.capacity();
+    }
+
+    /// Maximum number of subscribers
+    [[nodiscard]] std::size_t max_subscribers() const noexcept {
+        return subscribers.size();
+    }
+
+    // Deleted copy & move constructors and assignment-operators
+    MessageBus(const MessageBus&) = delete;
+    MessageBus(MessageBus&&) = delete;
+    MessageBus& operator=(const MessageBus&) = delete;
+    MessageBus& operator=(MessageBus&&) = delete;
+
+   private:
+    static constexpr std::uint8_t free_state = 0;
+    static constexpr std::uint8_t active_state = 1;
+    static constexpr std::uint8_t closing_state = 2;
+
+    struct Slot {
+        template <typename... Args>
+        explicit Slot(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {
+        }
+
+        std::atomic<std::uint32_t> refs{0};
+        T value;
+    };
+
+    // Ring of slot pointers; each side caches the other side's index so a push or pop only
+    // touches the shared line when the cached view says full or empty
+    struct Subscriber {
+        explicit Subscriber(std::size_t size) : ring(size), mask(size - 1) {
+        }
+
+        bool push(Slot* slot) noexcept {
+            const std::size_t t = tail.load(std::memory_order_relaxed);
+            if (t - head_cache == ring.size()) {
+                head_cache = head.load(std::memory_order_acquire);
+                if (t - head_cache == ring.size()) {
+                    return false;
+                }
+            }
+            ring[t & mask] = slot;
+            tail.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        Slot* pop() noexcept {
+            const std::size_t h = head.load(std::memory_order_relaxed);
+            if (h == tail_cache) {
+                tail_cache = tail.load(std::memory_order_acquire);
+                if (h == tail_cache) {
+                    return nullptr;
+                }
+            }
+            Slot* slot = ring[h & mask];
+            head.store(h + 1, std::memory_order_release);
+            return slot;
+        }
+
+        std::vector<Slot*> ring;
+        std::size_t mask;
+        std::atomic<std::uint8_t> state{free_state};
+        std::atomic<std::uint64_t> dropped{0};
+
+        // Consumer side
+        alignas(cache_line_size) std::atomic<std::size_t> head{0};
+        std::size_t tail_cache = 0;
+
+        // Producer side
+        alignas(cache_line_size) std::atomic<std::size_t> tail{0};
+        std::size_t head_cache = 0;
+    };
+
+    void release(Slot* slot, std::uint32_t count) noexcept {
+        if (slot->refs.fetch_sub(count, std::memory_order_acq_rel) == count) {
+            messages.deallocate_fast(slot);
+        }
+    }
+
+    // Publisher side: hand a closed subscriber slot back to subscribe()
+    void reclaim(Subscriber& sub) noexcept {
+        drain(sub);
+        sub.dropped.store(0, std::memory_order_relaxed);
+        sub.state.store(free_state, std::memory_order_release);
+    }
+
+    bool reclaim_closed() noexcept {
+        bool reclaimed = false;
+        const std::size_t limit = active_limit.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < limit; ++i) {
+            if (subscribers[i]->state.load(std::memory_order_acquire) == closing_state) {
+                reclaim(*subscribers[i]);
+                reclaimed = true;
+            }
+        }
+        return reclaimed;
+    }
+
+    // Release everything queued for a subscriber; the caller is its only consumer
+    void drain(Subscriber& sub) noexcept {
+        while (Slot* slot = sub.pop()) {
+            release(slot, 1);
+        }
+    }
+
+    LockFreeMemoryPool<Slot> messages;
+    std::vector<std::unique_ptr<Subscriber>> subscribers;
+    std::atomic<std::size_t> active_limit{0};  // One past the highest subscriber ever claimed
+};
+
+}  // namespace lfmemorypool
@@ -0,0 +1,167 @@
+#pragma once
+
+/*
+ * SpscHandoffChannel - Single-producer/single-consumer ring that hands pooled objects
+ * between two threads by 32-bit slot index
+ *
+ * - The ring holds LockFreeMemoryPool slot indices, not pointers or copies: sending an
+ *   object transfers its ownership to the consumer with one plain 4-byte store, and a
+ *   64-byte cache line of ring carries 16 messages
+ * - The producer publishes its tail every `batch` sends (or on flush()), and the consumer
+ *   returns consumed ring space every `batch` receives (or when it finds the ring empty),
+ *   so each side writes the shared index line once per batch rather than once per message
+ * - Each side caches the other's index and reloads it only when the cached view says the
+ *   ring is full or empty
+ *
+ * The channel never allocates or frees objects: the producer allocates from the pool before
+ * sending, and whatever the consumer receives is its to free or forward. One thread sends
+ * and one thread receives; objects sent but not yet flushed are invisible to the consumer.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <vector>
+#include "LockFreeMemoryPool.h"
+
+namespace lfmemorypool {
+
+/// Bounded SPSC channel transferring ownership of objects of one LockFreeMemoryPool<T>
+template <typename T>
+class SpscHandoffChannel final {
+   public:
+    /// Channel of `capacity` entries (rounded up to a power of two) publishing every
+    /// `batch` messages; batch 1 publishes each message as it is sent
+    SpscHandoffChannel(LockFreeMemoryPool<T>& source, std::size_t capacity,
+                       std::size_t batch_size = 16)
+        : pool(source),
+          ring(std::bit_ceil(std::max<std::size_t>(capacity, 1))),
+          mask(ring.size() - 1),
+          batch(std::clamp<std::size_t>(batch_size, 1, ring.size())) {
+        if (source.capacity() > UINT32_MAX) {
+            throw std::invalid_argument("SpscHandoffChannel: pool too large for 32-bit indices");
+        }
+    }
+
+    /// Producer: queue an object allocated from the pool; false when the ring is full
+    /// (the object stays with the caller). Published once `batch` sends are pending.
+    [[nodiscard]] bool try_send(T* object) noexcept {
+        if (producer.next - producer.head_cache == ring.size()) {
+            // Whatever is pending must become visible or the consumer can never free space
+            flush();
+            producer.head_cache = head.load(std::memory_order_acquire);
+            if (producer.next - producer.head_cache == ring.size()) {
+                return false;
+            }
+        }
+        ring[producer.next & mask] = static_cast<std::uint32_t>(pool.index_of(object));
+        if (++producer.next - producer.published >= batch) {
+            flush();
+        }
+        return true;
+    }
+
+    /// Producer: queue up to `count` objects and publish them together; returns how many
+    /// were taken (a prefix of `objects`)
+    std::size_t try_send_batch(T* const* objects, std::size_t count) noexcept {
+        std::size_t space = ring.size() - (producer.next - producer.head_cache);
+        if (space < count) {
+            producer.head_cache = head.load(std::memory_order_acquire);
+            space = ring.size() - (producer.next - producer.head_cache);
+        }
+        const std::size_t sent = std::min(space, count);
+        for (std::size_t i = 0; i < sent; ++i) {
+            ring[(producer.next + i) & mask] =
+                static_cast<std::uint32_t>(pool.index_of(objects[i]));
+        }
+        producer.next += sent;
+        flush();
+        return sent;
+    }
+
+    /// Producer: make every object sent so far visible to the consumer
+    void flush() noexcept {
+        if (producer.published != producer.next) {
+            producer.published = producer.next;
+            tail.store(producer.next, std::memory_order_release);
+        }
+    }
+
+    /// Consumer: take the oldest published object; nullptr when there is none
+    [[nodiscard]] T* try_receive() noexcept {
+        if (consumer.next == consumer.tail_cache) {
+            consumer.tail_cache = tail.load(std::memory_order_acquire);
+            if (consumer.next == consumer.tail_cache) {
+                release_consumed();  // Idle: hand back the space read so far
+                return nullptr;
+            }
+        }
+        T* object = pool.from_index(ring[consumer.next & mask]);
+        if (++consumer.next - consumer.released >= batch) {
+            release_consumed();
+        }
+        return object;
+    }
+
+    /// Consumer: take up to `max` published objects into `out`; returns how many
+    std::size_t try_receive_batch(T** out, std::size_t max) noexcept {
+        if (consumer.tail_cache - consumer.next < max) {
+            consumer.tail_cache = tail.load(std::memory_order_acquire);
+        }
+        const std::size_t received = std::min(consumer.tail_cache - consumer.next, max);
+        for (std::size_t i = 0; i < received; ++i) {
+            out[i] = pool.from_index(ring[(consumer.next + i) & mask]);
+        }
+        consumer.next += received;
+        release_consumed();
+        return received;
+    }
+
+    /// Number of ring entries
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return ring.size();
+    }
+
+    // Deleted copy & move constructors and assignment-operators
+    SpscHandoffChannel(const SpscHandoffChannel&) = delete;
+    SpscHandoffChannel(SpscHandoffChannel&&) = delete;
+    SpscHandoffChannel& operator=(const SpscHandoffChannel&) = delete;
+    SpscHandoffChannel& operator=(SpscHandoffChannel&&) = delete;
+
+   private:
+    void release_consumed() noexcept {
+        if (consumer.released != consumer.next) {
+            consumer.released = consumer.next;
+            head.store(consumer.next, std::memory_order_release);
+        }
+    }
+
+    // Positions are free-running counters; the ring index is the counter masked
+    struct alignas(cache_line_size) ProducerState {
+        std::size_t next = 0;        // Next position to write
+        std::size_t published = 0;   // Last tail stored
+        std::size_t head_cache = 0;  // Consumer position last seen
+    };
+
+    struct alignas(cache_line_size) ConsumerState {
+        std::size_t next = 0;        // Next position to read
+        std::size_t released = 0;    // Last head stored
+        std::size_t tail_cache = 0;  // Producer position last seen
+    };
+
+    LockFreeMemoryPool<T>& pool;
+    std::vector<std::uint32_t> ring;
+    std::size_t mask;
+    std::size_t batch;
+
+    ProducerState producer;
+    ConsumerState consumer;
+    alignas(cache_line_size) std::atomic<std::size_t> tail{0};  // Published by the producer
+    alignas(cache_line_size) std::atomic<std::size_t> head{0};  // Released by the consumer
+};
+
+}  // namespace lfmemorypool
@@ -0,0 +1,261 @@
+#pragma once
+
+/*
+ * TimerWheel - Hashed hierarchical timer wheel with pool-allocated timers
+ *
+ * - Four levels of 256 slots, each level 256 times coarser than the one below, cover 2^32
+ *   ticks ahead; timers further out wait in the top level and are re-filed as it turns
+ * - Timer entries come from a LockFreeMemoryPool owned by the wheel: arming never calls
+ *   malloc, and the pool capacity bounds the number of armed timers
+ * - Slots are intrusive doubly-linked lists of pool slot indices, so arm and cancel are O(1);
+ *   a TimerHandle is the slot index plus a generation, which turns cancelling a timer that
+ *   already fired (and whose slot may be reused) into a harmless no-op
+ * - advance() fires every timer due up to the given tick in one pass and re-files the
+ *   timers of a coarser slot into the finer levels when its turn comes; stretches with no
+ *   timer on the finer levels are skipped rather than walked tick by tick
+ *
+ * A wheel belongs to one thread (typically an event loop); it is not thread-safe.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "LockFreeMemoryPool.h"
+
+namespace lfmemorypool {
+
+/// Identifies an armed timer; stays safe to cancel after the timer fired or was cancelled
+struct TimerHandle {
+    std::uint32_t index = UINT32_MAX;
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] bool valid() const noexcept {
+        return index != UINT32_MAX;
+    }
+};
+
+/// Hierarchical timer wheel carrying a T per timer, fired through advance()
+template <typename T>
+class TimerWheel final {
+   public:
+    /// Wheel holding at most `capacity` armed timers, with its clock at `start_tick`
+    explicit TimerWheel(std::size_t capacity, std::uint64_t start_tick = 0)
+        : timers(capacity), generations(capacity, 0), current(start_tick) {
+        for (std::size_t slot = 0; slot < levels * slots_per_level; ++slot) {
+            heads[slot] = null_index;
+            tails[slot] = null_index;
+        }
+    }
+
+    ~TimerWheel() {
+        for (std::uint32_t& head : heads) {
+            while (head != null_index) {
+                Timer* timer = timers.from_index(head);
+                head = timer->next;
+                timers.deallocate_fast(timer);
+            }
+        }
+    }
+
+    /// Arm a timer firing at `expiry_tick` (the next tick if already due) carrying
+    /// T(args...); an invalid handle if the wheel is full
+    template <typename... Args>
+    [[nodiscard]] TimerHandle arm(std::uint64_t expiry_tick, Args&&... args) {
+        if (expiry_tick <= current) {
+            expiry_tick = current + 1;
+        }
+        Timer* timer = timers.allocate_fast(expiry_tick, std::forward<Args>(args)...);
+        if (!timer) {
+            return {};
+        }
+        const auto index = static_cast<std::uint32_t>(timers.index_of(timer));
+        link(index, timer);
+        ++armed;
+        return {index, generations[index]};
+    }
+
+    /// Disarm a timer; false if it already fired or was cancelled
+    bool cancel(TimerHandle handle) noexcept {
+        if (handle.index >= generations.size() || generations[handle.index] != handle.generation) {
+            return false;
+        }
+        Timer* timer = timers.from_index(handle.index);
+        unlink(timer);
+        ++generations[handle.index];
+        release(timer);
+        return true;
+    }
+
+    /// Move the clock to `now`, calling fn(T&) for every timer due on the way, in expiry
+    /// order; returns the number fired. fn may arm and cancel timers.
+    template <typename Fn>
+    std::size_t advance(std::uint64_t now, Fn&& fn) {
+        std::size_t fired = 0;
+        while (current < now) {
+            // Nothing fires or moves until the clock enters the next block of the finest
+            // level holding timers: jump to the tick before it
+            unsigned level = 0;
+            while (level < levels && level_counts[level] == 0) {
+                ++level;
+            }
+            if (level == levels) {
+                current = now;
+                break;
+            }
+            if (level > 0) {
+                const std::uint64_t block_end =
+                    current | ((std::uint64_t{1} << (slot_bits * level)) - 1);
+                if (block_end >= now) {
+                    current = now;
+                    break;
+                }
+                current = block_end;
+            }
+            ++current;
+            cascade();
+            std::uint32_t& head = heads[slot_for(0, current)];
+            while (head != null_index) {
+                const std::uint32_t index = head;
+                Timer* timer = timers.from_index(index);
+                unlink(timer);
+                ++generations[index];  // The handle is dead from here on
+                const Releaser releaser{*this, timer};
+                ++fired;
+                fn(timer->value);
+            }
+        }
+        return fired;
+    }
+
+    /// Current tick
+    [[nodiscard]] std::uint64_t now() const noexcept {
+        return current;
+    }
+
+    /// Number of armed timers
+    [[nodiscard]] std::size_t size() const noexcept {
+        return armed;
+    }
+
+    /// Maximum number of armed timers
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return timers.capacity();
+    }
+
+    // Deleted copy & move constructors and assignment-operators
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+
+   private:
+    static constexpr unsigned slot_bits = 8;
+    static constexpr std::size_t slots_per_level = std::size_t{1} << slot_bits;
+    static constexpr unsigned levels = 4;
+    static constexpr std::uint64_t max_delta = (std::uint64_t{1} << (slot_bits * levels)) - 1;
+    static constexpr std::uint32_t null_index = UINT32_MAX;
+
+    struct Timer {
+        template <typename... Args>
+        explicit Timer(std::uint64_t when, Args&&... args)
+            : expiry(when), value(std::forward<Args>(args)...) {
+        }
+
+        std::uint64_t expiry;
+        std::uint32_t prev = null_index;
+        std::uint32_t next = null_index;
+        std::uint32_t slot = 0;  // Index into heads
+        T value;
+    };
+
+    static std::size_t slot_for(unsigned level, std::uint64_t tick) noexcept {
+        return level * slots_per_level + ((tick >> (slot_bits * level)) & (slots_per_level - 1));
+    }
+
+    // File a timer on the finest level whose span covers its distance from the clock. On
+    // level l > 0 it is re-filed when the clock enters the block of 256^l ticks its expiry
+    // falls in, which is never later than the expiry itself.
+    void link(std::uint32_t index, Timer* timer) noexcept {
+        const std::uint64_t delta = timer->expiry - current;
+        const std::uint64_t filed_at = delta > max_delta ? current + max_delta : timer->expiry;
+        unsigned level = 0;
+        while (level + 1 < levels && delta >= (std::uint64_t{1} << (slot_bits * (level + 1)))) {
+            ++level;
+        }
+        const std::size_t slot = slot_for(level, filed_at);
+
+        timer->slot = static_cast<std::uint32_t>(slot);
+        timer->next = null_index;
+        timer->prev = tails[slot];
+        if (tails[slot] != null_index) {
+            timers.from_index(tails[slot])->next = index;
+        } else {
+            heads[slot] = index;
+        }
+        tails[slot] = index;
+        ++level_counts[level];
+    }
+
+    void unlink(Timer* timer) noexcept {
+        if (timer->prev != null_index) {
+            timers.from_index(timer->prev)->next = timer->next;
+        } else {
+            heads[timer->slot] = timer->next;
+        }
+        if (timer->next != null_index) {
+            timers.from_index(timer->next)->prev = timer->prev;
+        } else {
+            tails[timer->slot] = timer->prev;
+        }
+        --level_counts[timer->slot / slots_per_level];
+    }
+
+    void release(Timer* timer) noexcept {
+        timers.deallocate_fast(timer);
+        --armed;
+    }
+
+    // Returns a fired timer to the pool once its callback is done, even if it throws
+    struct Releaser {
+        TimerWheel& wheel;
+        Timer* timer;
+
+        ~Releaser() {
+            wheel.release(timer);
+        }
+    };
+
+    // When the clock enters a new 256^l block, the level-l slot for that block is re-filed
+    // into the finer levels; coarser levels first, so their timers trickle all the way down
+    void cascade() noexcept {
+        unsigned top = 0;
+        while (top + 1 < levels &&
+               (current & ((std::uint64_t{1} << (slot_bits * (top + 1))) - 1)) == 0) {
+            ++top;
+        }
+        for (unsigned level = top; level >= 1; --level) {
+            const std::size_t slot = slot_for(level, current);
+            std::uint32_t index = heads[slot];
+            heads[slot] = null_index;
+            tails[slot] = null_index;
+            while (index != null_index) {
+                Timer* timer = timers.from_index(index);
+                const std::uint32_t next = timer->next;
+                --level_counts[level];
+                link(index, timer);
+                index = next;
+            }
+        }
+    }
+
+    LockFreeMemoryPool<Timer> timers;
+    std::vector<std::uint32_t> generations;  // Per pool slot, bumped when a timer goes away
+    std::uint32_t heads[levels * slots_per_level];
+    std::uint32_t tails[levels * slots_per_level];
+    std::size_t level_counts[levels] = {};
+    std::uint64_t current;
+    std::size_t armed = 0;
+};
+
+}  // namespace lfmemorypool
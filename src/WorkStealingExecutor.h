@@ -0,0 +1,351 @@
+#pragma once
+
+/*
+ * WorkStealingExecutor - Work-stealing thread pool with pool-allocated tasks
+ *
+ * - Every worker owns a fixed-size Chase-Lev deque: it pushes and pops its own tasks at the
+ *   bottom (LIFO, cache-warm), idle workers steal from the top (FIFO, the oldest and usually
+ *   largest pieces of work)
+ * - A task is one cache line from a LockFreeMemoryPool shared by all workers, holding the
+ *   callable inline (up to inline_capacity bytes) and one function pointer: spawning and
+ *   completing a task never call malloc
+ * - Threads outside the pool submit through a LockFreeMPMCQueue injection queue
+ * - When the pool, a deque or the injection queue is full, the spawning thread runs the task
+ *   itself, so spawn() never fails and never blocks
+ * - wait_until() keeps the waiting thread executing tasks, so fork-join code can wait for
+ *   its children from inside a task without tying up a worker
+ *
+ * Tasks must not throw: an exception escaping a task calls std::terminate.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "LockFreeMPMCQueue.h"
+#include "LockFreeMemoryPool.h"
+
+namespace lfmemorypool {
+
+/// Work-stealing executor running void() callables from pooled, fixed-size task slots
+class WorkStealingExecutor final {
+   public:
+    /// Largest callable stored in a task (captures included)
+    static constexpr std::size_t inline_capacity = 48;
+
+    /// `threads` workers, at most `task_capacity` queued tasks, `deque_capacity` per worker
+    explicit WorkStealingExecutor(
+        std::size_t threads = std::max(1u, std::thread::hardware_concurrency()),
+        std::size_t task_capacity = 1 << 16, std::size_t deque_capacity = 1 << 12)
+        : tasks(task_capacity), injection(task_capacity) {
+        workers.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            workers.push_back(std::make_unique<Worker>(deque_capacity));
+        }
+        worker_threads.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i) {
+            worker_threads.emplace_back([this, i] { run_worker(i); });
+        }
+    }
+
+    /// Finishes every spawned task, then stops the workers
+    ~WorkStealingExecutor() {
+        wait_idle();
+        stopping.store(true, std::memory_order_release);
+        signal.fetch_add(1, std::memory_order_seq_cst);
+        signal.notify_all();
+        for (auto& thread : worker_threads) {
+            thread.join();
+        }
+    }
+
+    /// Queue fn() for execution; runs it right away if no task slot or queue space is free
+    template <typename F>
+    void spawn(F&& fn) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= inline_capacity,
+                      "WorkStealingExecutor: callable too large for inline task storage");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                      "WorkStealingExecutor: callable over-aligned for inline task storage");
+
+        Task* task = tasks.allocate_fast();
+        if (!task) {
+            fn();
+            return;
+        }
+        ::new (static_cast<void*>(task->storage)) Fn(std::forward<F>(fn));
+        task->run = &run_callable<Fn>;
+
+        if (Worker* self = current_worker(); self) {
+            // Counted before it becomes visible, so it cannot complete before being spawned
+            self->spawned.store(self->spawned.load(std::memory_order_relaxed) + 1,
+                                std::memory_order_release);
+            if (!self->deque.push(task)) {
+                execute(task, self);
+                return;
+            }
+        } else {
+            external_spawned.fetch_add(1, std::memory_order_release);
+            if (!injection.try_push(task)) {
+                execute(task, nullptr);
+                return;
+            }
+        }
+        wake_one();
+    }
+
+    /// Execute queued tasks on the calling thread until done() holds
+    template <typename Pred>
+    void wait_until(Pred&& done) {
+        Worker* self = current_worker();
+        while (!done()) {
+            if (Task* task = find_task(self)) {
+                execute(task, self);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /// Execute queued tasks on the calling thread until every spawned task has completed
+    void wait_idle() {
+        wait_until([this] { return idle(); });
+    }
+
+    /// Number of worker threads
+    [[nodiscard]] std::size_t thread_count() const noexcept {
+        return workers.size();
+    }
+
+    // Deleted copy & move constructors and assignment-operators
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor(WorkStealingExecutor&&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(WorkStealingExecutor&&) = delete;
+
+   private:
+    // One cache line: the callable, then the function that invokes and destroys it
+    struct alignas(cache_line_size) Task {
+        // User-provided, so pooled tasks are not zero-initialized
+        Task() {
+        }
+
+        alignas(std::max_align_t) unsigned char storage[inline_capacity];
+        void (*run)(Task&) noexcept;
+    };
+
+    // Chase-Lev deque over a fixed ring (Le et al., "Correct and Efficient Work-Stealing for
+    // Weak Memory Models"); the owner pushes and pops at bottom, thieves take from top
+    class Deque {
+       public:
+        explicit Deque(std::size_t capacity)
+            : mask(round_up_pow2(capacity) - 1),
+              buffer(std::make_unique<std::atomic<Task*>[]>(mask + 1)) {
+        }
+
+        bool push(Task* task) noexcept {
+            const std::int64_t b = bottom.load(std::memory_order_relaxed);
+            const std::int64_t t = top.load(std::memory_order_acquire);
+            if (b - t > static_cast<std::int64_t>(mask)) {
+                return false;  // Full
+            }
+            buffer[b & mask].store(task, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_release);
+            return true;
+        }
+
+        Task* pop() noexcept {
+            const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = top.load(std::memory_order_relaxed);
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);  // Empty
+                return nullptr;
+            }
+            Task* task = buffer[b & mask].load(std::memory_order_relaxed);
+            if (t == b) {
+                // Last task: race the thieves for it
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                 std::memory_order_relaxed)) {
+                    task = nullptr;
+                }
+                bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        Task* steal() noexcept {
+            std::int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const std::int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b) {
+                return nullptr;
+            }
+            Task* task = buffer[t & mask].load(std::memory_order_relaxed);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                return nullptr;  // Lost to the owner or another thief
+            }
+            return task;
+        }
+
+       private:
+        std::size_t mask;
+        std::unique_ptr<std::atomic<Task*>[]> buffer;
+        alignas(cache_line_size) std::atomic<std::int64_t> top{0};
+        alignas(cache_line_size) std::atomic<std::int64_t> bottom{0};
+    };
+
+    // Spawn and completion counts are written by the owning worker only
+    struct alignas(cache_line_size) Worker {
+        explicit Worker(std::size_t deque_capacity) : deque(deque_capacity) {
+        }
+
+        Deque deque;
+        alignas(cache_line_size) std::atomic<std::uint64_t> spawned{0};
+        std::atomic<std::uint64_t> completed{0};
+    };
+
+    struct WorkerSlot {
+        const WorkStealingExecutor* owner = nullptr;
+        Worker* worker = nullptr;
+    };
+
+    static constexpr unsigned spin_rounds = 64;  // Failed searches before a worker sleeps
+
+    template <typename Fn>
+    static void run_callable(Task& task) noexcept {
+        Fn& fn = *std::launder(reinterpret_cast<Fn*>(task.storage));
+        fn();
+        fn.~Fn();
+    }
+
+    static std::size_t round_up_pow2(std::size_t n) noexcept {
+        std::size_t pow2 = 1;
+        while (pow2 < n) {
+            pow2 <<= 1;
+        }
+        return pow2;
+    }
+
+    static WorkerSlot& worker_slot() noexcept {
+        thread_local WorkerSlot slot;
+        return slot;
+    }
+
+    Worker* current_worker() const noexcept {
+        const WorkerSlot& slot = worker_slot();
+        return slot.owner == this ? slot.worker : nullptr;
+    }
+
+    void execute(Task* task, Worker* self) noexcept {
+        task->run(*task);
+        tasks.deallocate_fast(task);
+        if (self) {
+            self->completed.store(self->completed.load(std::memory_order_relaxed) + 1,
+                                  std::memory_order_release);
+        } else {
+            external_completed.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    // Own deque first, then the injection queue, then the other workers from a random one
+    Task* find_task(Worker* self) noexcept {
+        if (self) {
+            if (Task* task = self->deque.pop()) {
+                return task;
+            }
+        }
+        Task* task = nullptr;
+        if (injection.try_pop(task)) {
+            return task;
+        }
+        const std::size_t count = workers.size();
+        const std::size_t start = detail::thread_random() % count;
+        for (std::size_t i = 0; i < count; ++i) {
+            Worker* victim = workers[(start + i) % count].get();
+            if (victim != self) {
+                if (Task* stolen = victim->deque.steal()) {
+                    return stolen;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // Completions are summed before spawns: equal sums mean every task spawned by the time
+    // the completions were read had completed, and no task was running to spawn more
+    bool idle() const noexcept {
+        std::uint64_t completed = external_completed.load(std::memory_order_acquire);
+        for (const auto& worker : workers) {
+            completed += worker->completed.load(std::memory_order_acquire);
+        }
+        std::uint64_t spawned = external_spawned.load(std::memory_order_acquire);
+        for (const auto& worker : workers) {
+            spawned += worker->spawned.load(std::memory_order_acquire);
+        }
+        return completed == spawned;
+    }
+
+    // A sleeping worker registers in `sleepers` before its last search; a spawner publishes
+    // its task before reading `sleepers`, so one of the two always sees the other
+    void wake_one() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) > 0) {
+            signal.fetch_add(1, std::memory_order_seq_cst);
+            signal.notify_one();
+        }
+    }
+
+    void run_worker(std::size_t index) {
+        Worker* self = workers[index].get();
+        worker_slot() = WorkerSlot{this, self};
+        unsigned failed = 0;
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (Task* task = find_task(self)) {
+                execute(task, self);
+                failed = 0;
+                continue;
+            }
+            if (++failed < spin_rounds) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            const std::uint32_t seen = signal.load(std::memory_order_seq_cst);
+            if (Task* task = find_task(self)) {
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+                execute(task, self);
+                failed = 0;
+                continue;
+            }
+            if (!stopping.load(std::memory_order_acquire)) {
+                signal.wait(seen, std::memory_order_seq_cst);
+            }
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            failed = 0;
+        }
+        worker_slot() = WorkerSlot{};
+    }
+
+    LockFreeMemoryPool<Task> tasks;
+    LockFreeMPMCQueue<Task*> injection;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> worker_threads;
+    alignas(cache_line_size) std::atomic<std::uint64_t> external_spawned{0};
+    std::atomic<std::uint64_t> external_completed{0};
+    alignas(cache_line_size) std::atomic<std::uint32_t> signal{0};
+    std::atomic<std::uint32_t> sleepers{0};
+    std::atomic<bool> stopping{false};
+};
+
+}  // namespace lfmemorypool
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/ClockCache.h"
+
+using namespace lfmemorypool;
+
+class ClockCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(ClockCacheTest, PutGetErase) {
+    ClockCache<int, std::string> cache(64, 4);
+    EXPECT_EQ(cache.capacity(), 64);
+    EXPECT_EQ(cache.size(), 0);
+
+    EXPECT_FALSE(cache.put(1, "one"));
+    EXPECT_FALSE(cache.put(2, std::string("two")));
+    EXPECT_FALSE(cache.put(1, "uno"));  // Overwrites in place
+    EXPECT_EQ(cache.size(), 2);
+
+    std::string value;
+    ASSERT_TRUE(cache.get(1, value));
+    EXPECT_EQ(value, "uno");
+    EXPECT_FALSE(cache.get(3, value));
+    EXPECT_TRUE(cache.contains(2));
+
+    EXPECT_TRUE(cache.erase(2));
+    EXPECT_FALSE(cache.erase(2));
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(ClockCacheTest, EvictsUnreferencedFirst) {
+    // One shard of four slots makes the clock order observable
+    ClockCache<int, int> cache(4, 1);
+    for (int key = 0; key < 4; ++key) {
+        EXPECT_FALSE(cache.put(key, key));
+    }
+
+    int value = 0;
+    ASSERT_TRUE(cache.get(0, value));  // 0 and 2 get a second chance
+    ASSERT_TRUE(cache.get(2, value));
+
+    EXPECT_TRUE(cache.put(4, 4));  // Evicts 1
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.put(5, 5));  // Evicts 3
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_EQ(cache.size(), 4);
+    for (const int key : {0, 2, 4, 5}) {
+        ASSERT_TRUE(cache.get(key, value));
+        EXPECT_EQ(value, key);
+    }
+}
+
+TEST_F(ClockCacheTest, EvictionReusesSlots) {
+    ClockCache<int, int> cache(32, 2);
+    int evictions = 0;
+    for (int key = 0; key < 10000; ++key) {
+        evictions += cache.put(key, key * 3);
+    }
+    EXPECT_EQ(cache.size(), cache.capacity());
+    EXPECT_EQ(evictions, 10000 - static_cast<int>(cache.capacity()));
+
+    // The most recent keys of each shard survive, with the values they were given
+    int found = 0;
+    for (int key = 0; key < 10000; ++key) {
+        int value = 0;
+        if (cache.get(key, value)) {
+            EXPECT_EQ(value, key * 3);
+            ++found;
+        }
+    }
+    EXPECT_EQ(found, static_cast<int>(cache.capacity()));
+
+    // An erased slot goes back to the pool and is used before anything is evicted
+    ASSERT_TRUE(cache.erase(9999));
+    EXPECT_FALSE(cache.put(9999, 0));
+}
+
+namespace {
+
+// Assignment from a negative value throws, so reusing an evicted slot can fail
+struct ThrowingValue {
+    ThrowingValue() = default;
+    explicit ThrowingValue(int v) : value(v) {}
+    ThrowingValue(const ThrowingValue&) = default;
+    ThrowingValue& operator=(const ThrowingValue& other) {
+        if (other.value < 0) {
+            throw std::runtime_error("assignment");
+        }
+        value = other.value;
+        return *this;
+    }
+    int value = 0;
+};
+
+}  // namespace
+
+TEST_F(ClockCacheTest, FailedReuseDropsVictim) {
+    ClockCache<int, ThrowingValue> cache(2, 1);
+    cache.put(1, ThrowingValue(1));
+    cache.put(2, ThrowingValue(2));
+    EXPECT_THROW(cache.put(3, ThrowingValue(-1)), std::runtime_error);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_FALSE(cache.contains(3));
+    EXPECT_FALSE(cache.put(4, ThrowingValue(4)));  // Takes the freed slot
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(ClockCacheTest, ConcurrentGetPut) {
+    constexpr int num_threads = 8;
+    constexpr int keys = 4096;
+    ClockCache<int, std::uint64_t> cache(1024, 8);
+    std::atomic<bool> wrong_value{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&cache, &wrong_value, t] {
+            std::uint32_t state = 2463534242u + t;
+            for (int op = 0; op < 50000; ++op) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                const int key = static_cast<int>(state % keys);
+                std::uint64_t value = 0;
+                if (cache.get(key, value)) {
+                    if (value != static_cast<std::uint64_t>(key) * 7) {
+                        wrong_value = true;
+                    }
+                } else if (op % 7 == 0) {
+                    cache.erase(key);
+                } else {
+                    cache.put(key, static_cast<std::uint64_t>(key) * 7);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(wrong_value.load());
+    EXPECT_LE(cache.size(), cache.capacity());
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../src/ConcurrentHashMap.h"
+
+using namespace lfmemorypool;
+
+class ConcurrentHashMapTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(ConcurrentHashMapTest, InsertFindErase) {
+    ConcurrentHashMap<int, std::string> map(100);
+    EXPECT_EQ(map.capacity(), 100);
+    EXPECT_EQ(map.size(), 0);
+
+    EXPECT_TRUE(map.try_emplace(1, "one"));
+    EXPECT_TRUE(map.try_emplace(2, 3, 'x'));  // Value constructed in place: "xxx"
+    EXPECT_FALSE(map.try_emplace(1, "uno"));  // Existing key is left unchanged
+    EXPECT_EQ(map.size(), 2);
+
+    std::string value;
+    ASSERT_TRUE(map.find(1, value));
+    EXPECT_EQ(value, "one");
+    ASSERT_TRUE(map.find(2, value));
+    EXPECT_EQ(value, "xxx");
+    EXPECT_FALSE(map.find(3, value));
+    EXPECT_TRUE(map.contains(2));
+
+    EXPECT_TRUE(map.erase(1));
+    EXPECT_FALSE(map.erase(1));
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_EQ(map.size(), 1);
+}
+
+TEST_F(ConcurrentHashMapTest, InsertOrAssignAndUpdate) {
+    ConcurrentHashMap<std::string, int> map(10);
+
+    EXPECT_TRUE(map.insert_or_assign("a", 1));
+    EXPECT_TRUE(map.insert_or_assign("a", 2));
+    EXPECT_EQ(map.size(), 1);
+
+    int value = 0;
+    ASSERT_TRUE(map.find("a", value));
+    EXPECT_EQ(value, 2);
+
+    EXPECT_TRUE(map.update("a", [](int& v) { v *= 10; }));
+    EXPECT_FALSE(map.update("b", [](int& v) { v = -1; }));
+    ASSERT_TRUE(map.find("a", value));
+    EXPECT_EQ(value, 20);
+}
+
+TEST_F(ConcurrentHashMapTest, BoundedByCapacity) {
+    ConcurrentHashMap<int, int> map(4);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(map.try_emplace(i, i));
+    }
+    EXPECT_FALSE(map.try_emplace(4, 4));
+    EXPECT_FALSE(map.insert_or_assign(4, 4));
+    EXPECT_TRUE(map.insert_or_assign(0, 100));  // Overwriting needs no new node
+
+    // Erasing returns the node to the pool
+    ASSERT_TRUE(map.erase(2));
+    EXPECT_TRUE(map.try_emplace(4, 4));
+    EXPECT_EQ(map.size(), 4);
+}
+
+TEST_F(ConcurrentHashMapTest, CollidingKeys) {
+    // Keys differing only in high bits share low hash bits before mixing
+    ConcurrentHashMap<std::uint64_t, int> map(64, 4);
+    for (int i = 0; i < 64; ++i) {
+        ASSERT_TRUE(map.try_emplace(static_cast<std::uint64_t>(i) << 40, i));
+    }
+    for (int i = 0; i < 64; ++i) {
+        int value = -1;
+        ASSERT_TRUE(map.find(static_cast<std::uint64_t>(i) << 40, value));
+        EXPECT_EQ(value, i);
+    }
+    for (int i = 0; i < 64; i += 2) {
+        EXPECT_TRUE(map.erase(static_cast<std::uint64_t>(i) << 40));
+    }
+    EXPECT_EQ(map.size(), 32);
+    EXPECT_FALSE(map.contains(0));
+    EXPECT_TRUE(map.contains(std::uint64_t{1} << 40));
+}
+
+TEST_F(ConcurrentHashMapTest, ConcurrentMixedOperations) {
+    constexpr int num_threads = 8;
+    constexpr int keys_per_thread = 2000;
+    ConcurrentHashMap<int, int> map(num_threads * keys_per_thread, 16);
+    std::atomic<bool> wrong_value{false};
+
+    // Every thread owns a key range; all of them read each other's ranges meanwhile
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&map, &wrong_value, t] {
+            const int base = t * keys_per_thread;
+            for (int round = 0; round < 3; ++round) {
+                for (int k = base; k < base + keys_per_thread; ++k) {
+                    if (!map.try_emplace(k, k * 2)) {
+                        wrong_value = true;
+                    }
+                    int value = 0;
+                    const int other = (k + keys_per_thread * 3) % (num_threads * keys_per_thread);
+                    if (map.find(other, value) && value != other * 2) {
+                        wrong_value = true;
+                    }
+                }
+                for (int k = base; k < base + keys_per_thread; k += 2) {
+                    if (!map.erase(k)) {
+                        wrong_value = true;
+                    }
+                }
+                if (round < 2) {
+                    for (int k = base + 1; k < base + keys_per_thread; k += 2) {
+                        map.erase(k);
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // The last round kept the odd keys
+    EXPECT_FALSE(wrong_value.load());
+    EXPECT_EQ(map.size(), static_cast<std::size_t>(num_threads * keys_per_thread / 2));
+    for (int k = 0; k < num_threads * keys_per_thread; ++k) {
+        int value = 0;
+        EXPECT_EQ(map.find(k, value), k % 2 == 1);
+    }
+}
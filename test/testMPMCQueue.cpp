@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../src/LockFreeMPMCQueue.h"
+
+using namespace lfmemorypool;
+
+namespace {
+
+struct Counted {
+    static inline std::atomic<int> live{0};
+    int value = 0;
+
+    explicit Counted(int v) : value(v) {
+        ++live;
+    }
+    Counted(const Counted& other) : value(other.value) {
+        ++live;
+    }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) noexcept = default;
+    ~Counted() {
+        --live;
+    }
+};
+
+struct ThrowingValue {
+    int value = 0;
+
+    explicit ThrowingValue(int v) : value(v) {
+        if (v < 0) {
+            throw std::runtime_error("negative value");
+        }
+    }
+    ThrowingValue& operator=(ThrowingValue&&) noexcept = default;
+};
+
+}  // namespace
+
+class LockFreeMPMCQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(LockFreeMPMCQueueTest, FifoOrder) {
+    LockFreeMPMCQueue<int> queue(16);
+    EXPECT_EQ(queue.capacity(), 16);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.empty());
+
+    int value = -1;
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(LockFreeMPMCQueueTest, BoundedByCapacity) {
+    LockFreeMPMCQueue<int> queue(4);
+
+    // Several rounds so every pool slot serves as node and as dummy head
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(queue.try_push(round * 10 + i));
+        }
+        EXPECT_FALSE(queue.try_push(99));
+
+        int value = -1;
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, round * 10);
+        EXPECT_TRUE(queue.try_push(99));
+
+        for (int i = 1; i < 4; ++i) {
+            ASSERT_TRUE(queue.try_pop(value));
+            EXPECT_EQ(value, round * 10 + i);
+        }
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, 99);
+        EXPECT_FALSE(queue.try_pop(value));
+    }
+}
+
+TEST_F(LockFreeMPMCQueueTest, MoveOnlyValues) {
+    LockFreeMPMCQueue<std::unique_ptr<int>> queue(8);
+    ASSERT_TRUE(queue.try_push(std::make_unique<int>(7)));
+    ASSERT_TRUE(queue.try_emplace(new int(8)));
+
+    std::unique_ptr<int> value;
+    ASSERT_TRUE(queue.try_pop(value));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 7);
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(*value, 8);
+}
+
+TEST_F(LockFreeMPMCQueueTest, DestructorDestroysQueuedValues) {
+    Counted::live = 0;
+    {
+        LockFreeMPMCQueue<Counted> queue(8);
+        for (int i = 0; i < 5; ++i) {
+            ASSERT_TRUE(queue.try_emplace(i));
+        }
+        Counted out(-1);
+        ASSERT_TRUE(queue.try_pop(out));
+        EXPECT_EQ(out.value, 0);
+        EXPECT_EQ(Counted::live, 5);  // Four queued plus `out`
+    }
+    EXPECT_EQ(Counted::live, 0);
+}
+
+TEST_F(LockFreeMPMCQueueTest, ConstructorExceptionHandling) {
+    LockFreeMPMCQueue<ThrowingValue> queue(2);
+    EXPECT_THROW({ [[maybe_unused]] bool pushed = queue.try_emplace(-1); }, std::runtime_error);
+
+    // The slot of the failed element went back to the pool
+    ASSERT_TRUE(queue.try_emplace(1));
+    ASSERT_TRUE(queue.try_emplace(2));
+    EXPECT_FALSE(queue.try_emplace(3));
+
+    ThrowingValue out(0);
+    ASSERT_TRUE(queue.try_pop(out));
+    EXPECT_EQ(out.value, 1);
+}
+
+TEST_F(LockFreeMPMCQueueTest, ConcurrentProducersConsumers) {
+    constexpr int num_producers = 4;
+    constexpr int num_consumers = 4;
+    constexpr std::uint32_t items_per_producer = 20000;
+    LockFreeMPMCQueue<std::uint64_t> queue(64);  // Small: producers regularly find it full
+
+    std::atomic<std::uint64_t> consumed{0};
+    std::atomic<std::uint64_t> checksum{0};
+    std::atomic<bool> order_violation{false};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < num_producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (std::uint32_t seq = 0; seq < items_per_producer; ++seq) {
+                const std::uint64_t item = (static_cast<std::uint64_t>(p) << 32) | seq;
+                while (!queue.try_push(item)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&] {
+            // FIFO per producer: each consumer sees a producer's sequence numbers ascending
+            std::vector<std::int64_t> last_seq(num_producers, -1);
+            const std::uint64_t total = std::uint64_t{num_producers} * items_per_producer;
+            std::uint64_t item = 0;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (!queue.try_pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                const auto producer = static_cast<std::size_t>(item >> 32);
+                const auto seq = static_cast<std::int64_t>(item & 0xffffffff);
+                if (seq <= last_seq[producer]) {
+                    order_violation = true;
+                }
+                last_seq[producer] = seq;
+                checksum.fetch_add(item, std::memory_order_relaxed);
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::uint64_t expected_checksum = 0;
+    for (std::uint64_t p = 0; p < num_producers; ++p) {
+        for (std::uint64_t seq = 0; seq < items_per_producer; ++seq) {
+            expected_checksum += (p << 32) | seq;
+        }
+    }
+    EXPECT_EQ(consumed.load(), std::uint64_t{num_producers} * items_per_producer);
+    EXPECT_EQ(checksum.load(), expected_checksum);
+    EXPECT_FALSE(order_violation.load());
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "../src/MessageBus.h"
+
+using namespace lfmemorypool;
+
+class MessageBusTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+namespace {
+
+// Message that tracks how many instances are alive
+struct Tracked {
+    Tracked(std::atomic<int>& live, std::uint64_t seq) : live(&live), seq(seq) {
+        live.fetch_add(1, std::memory_order_relaxed);
+    }
+    ~Tracked() {
+        live->fetch_sub(1, std::memory_order_relaxed);
+    }
+    std::atomic<int>* live;
+    std::uint64_t seq;
+};
+
+}  // namespace
+
+TEST_F(MessageBusTest, FanOutSharesOneSlot) {
+    MessageBus<int> bus(4, 16, 8);
+    EXPECT_EQ(bus.capacity(), 4);
+    EXPECT_EQ(bus.max_subscribers(), 8);
+
+    const std::size_t a = bus.subscribe();
+    const std::size_t b = bus.subscribe();
+    const std::size_t c = bus.subscribe();
+    ASSERT_NE(c, MessageBus<int>::no_subscriber);
+    ASSERT_TRUE(bus.try_publish(42));
+
+    MessageBus<int>::Handle ha, hb, hc;
+    ASSERT_TRUE(bus.poll(a, ha));
+    ASSERT_TRUE(bus.poll(b, hb));
+    ASSERT_TRUE(bus.poll(c, hc));
+    EXPECT_EQ(*ha, 42);
+    EXPECT_EQ(&*ha, &*hb);  // One copy of the payload for every subscriber
+    EXPECT_EQ(&*hb, &*hc);
+    EXPECT_FALSE(bus.poll(a, ha));  // A failed poll leaves the handle alone
+    EXPECT_TRUE(ha);
+}
+
+TEST_F(MessageBusTest, SlotReturnsAfterLastRelease) {
+    MessageBus<int> bus(1);
+    const std::size_t a = bus.subscribe();
+    const std::size_t b = bus.subscribe();
+    ASSERT_TRUE(bus.try_publish(1));
+    EXPECT_FALSE(bus.try_publish(2));  // The only slot is still referenced
+
+    MessageBus<int>::Handle ha, hb;
+    ASSERT_TRUE(bus.poll(a, ha));
+    ASSERT_TRUE(bus.poll(b, hb));
+    MessageBus<int>::Handle copy = ha;
+    ha.reset();
+    hb.reset();
+    EXPECT_FALSE(bus.try_publish(3));  // The copy holds a reference
+    copy.reset();
+    EXPECT_TRUE(bus.try_publish(4));
+
+    // Unsubscribing releases what is still queued; without subscribers a message is
+    // released as soon as it is published
+    bus.unsubscribe(a);
+    bus.unsubscribe(b);
+    EXPECT_TRUE(bus.try_publish(5));
+    EXPECT_TRUE(bus.try_publish(6));
+}
+
+TEST_F(MessageBusTest, FullRingDropsMessage) {
+    MessageBus<int> bus(16, 2);
+    const std::size_t slow = bus.subscribe();
+    const std::size_t fast = bus.subscribe();
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(bus.try_publish(i));
+        MessageBus<int>::Handle h;
+        ASSERT_TRUE(bus.poll(fast, h));
+        EXPECT_EQ(*h, i);
+    }
+    EXPECT_EQ(bus.dropped(slow), 3);
+    EXPECT_EQ(bus.dropped(fast), 0);
+
+    // The slow subscriber kept the two oldest messages
+    MessageBus<int>::Handle h;
+    ASSERT_TRUE(bus.poll(slow, h));
+    EXPECT_EQ(*h, 0);
+    ASSERT_TRUE(bus.poll(slow, h));
+    EXPECT_EQ(*h, 1);
+    EXPECT_FALSE(bus.poll(slow, h));
+}
+
+TEST_F(MessageBusTest, SubscriberSlotsAreRecycled) {
+    MessageBus<int> bus(4, 4, 2);
+    const std::size_t a = bus.subscribe();
+    const std::size_t b = bus.subscribe();
+    EXPECT_EQ(bus.subscribe(), MessageBus<int>::no_subscriber);
+
+    ASSERT_TRUE(bus.try_publish(1));
+    ASSERT_TRUE(bus.try_publish(2));
+    bus.unsubscribe(a);  // Releases a's queued messages
+    EXPECT_EQ(bus.subscribe(), MessageBus<int>::no_subscriber);  // Not yet reclaimed
+
+    ASSERT_TRUE(bus.try_publish(3));  // The publisher reclaims a's slot
+    EXPECT_EQ(bus.subscribe(), a);
+
+    // The new subscriber starts with an empty ring
+    MessageBus<int>::Handle h;
+    EXPECT_FALSE(bus.poll(a, h));
+    ASSERT_TRUE(bus.poll(b, h));
+    EXPECT_EQ(*h, 1);
+}
+
+TEST_F(MessageBusTest, DestructorReleasesQueuedMessages) {
+    std::atomic<int> live{0};
+    {
+        MessageBus<Tracked> bus(8);
+        ASSERT_NE(bus.subscribe(), MessageBus<Tracked>::no_subscriber);
+        ASSERT_NE(bus.subscribe(), MessageBus<Tracked>::no_subscriber);
+        for (std::uint64_t i = 0; i < 5; ++i) {
+            ASSERT_TRUE(bus.try_publish(live, i));
+        }
+        EXPECT_EQ(live.load(), 5);
+    }
+    EXPECT_EQ(live.load(), 0);
+}
+
+TEST_F(MessageBusTest, ConcurrentFanOut) {
+    constexpr int num_subscribers = 4;
+    constexpr std::uint64_t num_messages = 20000;
+    std::atomic<int> live{0};
+    {
+        // Rings as large as the pool: a queued message holds a slot, so no ring overflows
+        MessageBus<Tracked> bus(256, 256, num_subscribers + 1);
+        std::vector<std::size_t> ids;
+        for (int i = 0; i < num_subscribers; ++i) {
+            ids.push_back(bus.subscribe());
+        }
+
+        std::atomic<bool> out_of_order{false};
+        std::atomic<bool> publishing{true};
+        std::vector<std::thread> threads;
+        for (const std::size_t id : ids) {
+            threads.emplace_back([&bus, &out_of_order, id] {
+                std::uint64_t expected = 0;
+                MessageBus<Tracked>::Handle h;
+                while (expected < num_messages) {
+                    if (bus.poll(id, h)) {
+                        out_of_order = out_of_order || h->seq != expected;
+                        ++expected;
+                        h.reset();
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        // Subscribes and unsubscribes while messages flow
+        threads.emplace_back([&bus, &publishing] {
+            MessageBus<Tracked>::Handle h;
+            while (publishing.load()) {
+                const std::size_t id = bus.subscribe();
+                if (id != MessageBus<Tracked>::no_subscriber) {
+                    for (int i = 0; i < 16; ++i) {
+                        (void)bus.poll(id, h);
+                    }
+                    h.reset();
+                    bus.unsubscribe(id);
+                }
+                std::this_thread::yield();
+            }
+        });
+
+        for (std::uint64_t seq = 0; seq < num_messages; ++seq) {
+            while (!bus.try_publish(live, seq)) {
+                std::this_thread::yield();
+            }
+        }
+        publishing = false;
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        EXPECT_FALSE(out_of_order.load());
+        for (const std::size_t id : ids) {
+            EXPECT_EQ(bus.dropped(id), 0);
+        }
+    }
+    EXPECT_EQ(live.load(), 0);
+}
@@ -151,6 +151,87 @@ TEST_F(LockFreeMemoryPoolTest, PoolStatistics) {
 
 }
 
+TEST_F(LockFreeMemoryPoolTest, FragmentationStatistics) {
+    const size_t pool_size = 10;
+    LockFreeMemoryPool<int> pool(pool_size);
+
+    auto frag = lfmemorypool::stats::get_fragmentation_stats(pool);
+    EXPECT_EQ(frag.free_objects, pool_size);
+    EXPECT_EQ(frag.free_runs, 1);
+    EXPECT_EQ(frag.largest_free_run, pool_size);
+    EXPECT_DOUBLE_EQ(frag.fragmentation, 0.0);
+
+    std::vector<int*> ptrs;
+    for (int i = 0; i < 10; ++i) {
+        int* ptr = pool.allocate_fast(i);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+
+    frag = lfmemorypool::stats::get_fragmentation_stats(pool);
+    EXPECT_EQ(frag.free_objects, 0);
+    EXPECT_EQ(frag.free_runs, 0);
+    EXPECT_DOUBLE_EQ(frag.mean_free_run, 0.0);
+    EXPECT_DOUBLE_EQ(frag.fragmentation, 0.0);
+
+    // Free slots 1, 3, 4 and 6-8 (allocation order matches slot order in a fresh pool)
+    for (int i : {1, 3, 4, 6, 7, 8}) {
+        pool.deallocate_fast(ptrs[i]);
+    }
+
+    frag = lfmemorypool::stats::get_fragmentation_stats(pool);
+    EXPECT_EQ(frag.free_objects, 6);
+    EXPECT_EQ(frag.free_runs, 3);
+    EXPECT_EQ(frag.largest_free_run, 3);
+    EXPECT_DOUBLE_EQ(frag.mean_free_run, 2.0);
+    EXPECT_DOUBLE_EQ(frag.fragmentation, 0.5);
+
+    for (int i : {0, 2, 5, 9}) {
+        pool.deallocate_fast(ptrs[i]);
+    }
+}
+
+TEST_F(LockFreeMemoryPoolTest, SlotIndexRoundTrip) {
+    LockFreeMemoryPool<Foo> pool(8);
+    EXPECT_EQ(pool.capacity(), 8);
+
+    std::vector<Foo*> ptrs;
+    for (int i = 0; i < 8; ++i) {
+        Foo* ptr = pool.allocate_fast(i, "slot");
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+
+    // Every slot index appears once and maps back to the same object
+    std::vector<bool> seen(pool.capacity(), false);
+    for (Foo* ptr : ptrs) {
+        const size_t index = pool.index_of(ptr);
+        ASSERT_LT(index, pool.capacity());
+        EXPECT_FALSE(seen[index]);
+        seen[index] = true;
+        EXPECT_EQ(pool.from_index(index), ptr);
+        EXPECT_EQ(pool.from_index(index)->value, ptr->value);
+    }
+
+    for (Foo* ptr : ptrs) {
+        pool.deallocate_fast(ptr);
+    }
+}
+
+#ifndef NDEBUG
+TEST_F(LockFreeMemoryPoolTest, SlotIndexRejectsForeignPointers) {
+    LockFreeMemoryPool<Foo> pool(4);
+    LockFreeMemoryPool<Foo> other(4);
+    Foo* foreign = other.allocate_fast(1, "other");
+    ASSERT_NE(foreign, nullptr);
+
+    EXPECT_DEATH(static_cast<void>(pool.index_of(foreign)), "Invalid pointer in index_of");
+    EXPECT_DEATH(static_cast<void>(pool.from_index(pool.capacity())),
+                 "Invalid index in from_index");
+    other.deallocate_fast(foreign);
+}
+#endif
+
 // Global pool tests
 TEST_F(GlobalLockFreeMemoryPoolTest, PoolAllocationFoo) {
     // Test global safe allocation
@@ -292,6 +373,9 @@ TEST_F(GlobalLockFreeMemoryPoolTest, ConcurrentAllocationDeallocation) {
             }
         });
     }
+    // jthreads join only on destruction; without this the check below could run before any
+    // worker had been scheduled (seen on single-CPU runners) and fail with zero operations
+    threads.clear();
     EXPECT_GT(successful_operations.load(), 0);
 }
 
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../src/LockFreeSkipList.h"
+
+using namespace lfmemorypool;
+
+class SkipListTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(SkipListTest, InsertFindErase) {
+    LockFreeSkipList<int, std::string> list(100);
+    EXPECT_EQ(list.capacity(), 100);
+    EXPECT_EQ(list.size(), 0);
+
+    EXPECT_TRUE(list.try_emplace(2, "two"));
+    EXPECT_TRUE(list.try_emplace(1, 3, 'x'));  // Value constructed in place: "xxx"
+    EXPECT_FALSE(list.try_emplace(2, "deux"));  // Existing key is left unchanged
+    EXPECT_EQ(list.size(), 2);
+
+    std::string value;
+    ASSERT_TRUE(list.find(2, value));
+    EXPECT_EQ(value, "two");
+    ASSERT_TRUE(list.find(1, value));
+    EXPECT_EQ(value, "xxx");
+    EXPECT_FALSE(list.find(3, value));
+
+    EXPECT_TRUE(list.erase(2));
+    EXPECT_FALSE(list.erase(2));
+    EXPECT_FALSE(list.contains(2));
+    EXPECT_TRUE(list.contains(1));
+    EXPECT_EQ(list.size(), 1);
+
+    // A key can come back after being erased
+    EXPECT_TRUE(list.try_emplace(2, "again"));
+    ASSERT_TRUE(list.find(2, value));
+    EXPECT_EQ(value, "again");
+}
+
+TEST_F(SkipListTest, ScanIsOrderedAndHalfOpen) {
+    LockFreeSkipList<int, int> list(1000);
+    // Insert in a scrambled order
+    for (int i = 0; i < 1000; ++i) {
+        const int key = (i * 617) % 1000;
+        ASSERT_TRUE(list.try_emplace(key, key * 10));
+    }
+    for (int key = 0; key < 1000; key += 3) {
+        ASSERT_TRUE(list.erase(key));
+    }
+
+    std::vector<std::pair<int, int>> seen;
+    const std::size_t visited = list.scan(100, 200, [&seen](int key, int value) {
+        seen.emplace_back(key, value);
+    });
+    EXPECT_EQ(visited, seen.size());
+
+    std::vector<std::pair<int, int>> expected;
+    for (int key = 100; key < 200; ++key) {
+        if (key % 3 != 0) {
+            expected.emplace_back(key, key * 10);
+        }
+    }
+    EXPECT_EQ(seen, expected);
+    EXPECT_EQ(list.scan(2000, 3000, [](int, int) {}), 0u);
+}
+
+TEST_F(SkipListTest, CustomComparator) {
+    LockFreeSkipList<int, int, std::greater<int>> list(10);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(list.try_emplace(i, i));
+    }
+    std::vector<int> keys;
+    list.scan(10, -1, [&keys](int key, int) { keys.push_back(key); });
+    EXPECT_EQ(keys, (std::vector<int>{4, 3, 2, 1, 0}));
+}
+
+TEST_F(SkipListTest, BoundedByPools) {
+    // The pools hold at least `capacity` nodes in total, whatever the heights drawn
+    LockFreeSkipList<int, int> list(64);
+    int inserted = 0;
+    while (list.try_emplace(inserted, inserted)) {
+        ++inserted;
+    }
+    EXPECT_GE(inserted, 64);
+    EXPECT_EQ(list.size(), static_cast<std::size_t>(inserted));
+
+    // Erased nodes go back to their pools once their grace period has passed
+    for (int key = 0; key < inserted; ++key) {
+        ASSERT_TRUE(list.erase(key));
+    }
+    for (int key = 0; key < 64; ++key) {
+        ASSERT_TRUE(list.try_emplace(key, key));
+    }
+}
+
+TEST_F(SkipListTest, MatchesStdMap) {
+    LockFreeSkipList<unsigned, unsigned> list(4096);
+    std::map<unsigned, unsigned> reference;
+    unsigned state = 12345;
+    for (int op = 0; op < 20000; ++op) {
+        state = state * 1103515245u + 12345u;
+        const unsigned key = (state >> 8) % 2048;
+        if ((state >> 20) % 2 == 0) {
+            EXPECT_EQ(list.try_emplace(key, key + 1), reference.emplace(key, key + 1).second);
+        } else {
+            EXPECT_EQ(list.erase(key), reference.erase(key) == 1);
+        }
+    }
+    EXPECT_EQ(list.size(), reference.size());
+
+    std::vector<std::pair<unsigned, unsigned>> contents;
+    list.scan(0, 2048, [&contents](unsigned key, unsigned value) {
+        contents.emplace_back(key, value);
+    });
+    EXPECT_EQ(contents, (std::vector<std::pair<unsigned, unsigned>>(reference.begin(),
+                                                                     reference.end())));
+}
+
+TEST_F(SkipListTest, ConcurrentInsertEraseScan) {
+    constexpr int num_threads = 8;
+    constexpr int keys_per_thread = 2000;
+    LockFreeSkipList<int, int> list(num_threads * keys_per_thread);
+    std::atomic<bool> wrong_value{false};
+    std::atomic<bool> stop{false};
+
+    // A scanner checks ordering and values while the writers churn
+    std::thread scanner([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            int previous = -1;
+            list.scan(0, num_threads * keys_per_thread, [&](int key, int value) {
+                if (key <= previous || value != key * 2) {
+                    wrong_value = true;
+                }
+                previous = key;
+            });
+        }
+    });
+
+    // Keys interleave across threads, so neighbours are always contended
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&list, &wrong_value, t] {
+            for (int round = 0; round < 3; ++round) {
+                for (int k = t; k < num_threads * keys_per_thread; k += num_threads) {
+                    if (!list.try_emplace(k, k * 2)) {
+                        wrong_value = true;
+                    }
+                }
+                for (int k = t; k < num_threads * keys_per_thread; k += num_threads) {
+                    if ((round < 2 || k % 2 == 0) && !list.erase(k)) {
+                        wrong_value = true;
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    stop = true;
+    scanner.join();
+
+    // The last round kept the odd keys
+    EXPECT_FALSE(wrong_value.load());
+    EXPECT_EQ(list.size(), static_cast<std::size_t>(num_threads * keys_per_thread / 2));
+    for (int k = 0; k < num_threads * keys_per_thread; ++k) {
+        EXPECT_EQ(list.contains(k), k % 2 == 1);
+    }
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "../src/SpscHandoffChannel.h"
+
+using namespace lfmemorypool;
+
+class SpscHandoffChannelTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+namespace {
+
+struct Message {
+    explicit Message(std::uint64_t seq) : seq(seq) {}
+    std::uint64_t seq;
+};
+
+}  // namespace
+
+TEST_F(SpscHandoffChannelTest, DeliversInOrder) {
+    LockFreeMemoryPool<Message> pool(16);
+    SpscHandoffChannel<Message> channel(pool, 10, 1);
+    EXPECT_EQ(channel.capacity(), 16);
+    EXPECT_EQ(channel.try_receive(), nullptr);
+
+    std::vector<Message*> sent;
+    for (std::uint64_t i = 0; i < 5; ++i) {
+        sent.push_back(pool.allocate_fast(i));
+        ASSERT_TRUE(channel.try_send(sent.back()));
+    }
+    for (Message* expected : sent) {
+        Message* received = channel.try_receive();
+        ASSERT_EQ(received, expected);  // The same object, not a copy
+        pool.deallocate_fast(received);
+    }
+    EXPECT_EQ(channel.try_receive(), nullptr);
+}
+
+TEST_F(SpscHandoffChannelTest, PublishesInBatches) {
+    LockFreeMemoryPool<Message> pool(16);
+    SpscHandoffChannel<Message> channel(pool, 16, 4);
+
+    for (std::uint64_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(channel.try_send(pool.allocate_fast(i)));
+    }
+    EXPECT_EQ(channel.try_receive(), nullptr);  // Three pending, not yet published
+    ASSERT_TRUE(channel.try_send(pool.allocate_fast(3)));
+    for (std::uint64_t i = 0; i < 4; ++i) {
+        Message* received = channel.try_receive();
+        ASSERT_NE(received, nullptr);
+        EXPECT_EQ(received->seq, i);
+        pool.deallocate_fast(received);
+    }
+
+    ASSERT_TRUE(channel.try_send(pool.allocate_fast(4)));
+    EXPECT_EQ(channel.try_receive(), nullptr);
+    channel.flush();
+    Message* received = channel.try_receive();
+    ASSERT_NE(received, nullptr);
+    EXPECT_EQ(received->seq, 4);
+    pool.deallocate_fast(received);
+}
+
+TEST_F(SpscHandoffChannelTest, FullRingWaitsForReleasedSpace) {
+    LockFreeMemoryPool<Message> pool(16);
+    SpscHandoffChannel<Message> channel(pool, 4, 4);
+
+    std::array<Message*, 5> objects{};
+    for (std::uint64_t i = 0; i < objects.size(); ++i) {
+        objects[i] = pool.allocate_fast(i);
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(channel.try_send(objects[i]));
+    }
+    EXPECT_FALSE(channel.try_send(objects[4]));
+
+    // Space read but not yet released stays unavailable to the producer
+    ASSERT_EQ(channel.try_receive(), objects[0]);
+    EXPECT_FALSE(channel.try_send(objects[4]));
+    for (std::size_t i = 1; i < 4; ++i) {
+        ASSERT_EQ(channel.try_receive(), objects[i]);
+    }
+    EXPECT_TRUE(channel.try_send(objects[4]));
+    channel.flush();
+    EXPECT_EQ(channel.try_receive(), objects[4]);
+}
+
+TEST_F(SpscHandoffChannelTest, BatchCalls) {
+    LockFreeMemoryPool<Message> pool(16);
+    SpscHandoffChannel<Message> channel(pool, 8);
+
+    std::array<Message*, 12> objects{};
+    for (std::uint64_t i = 0; i < objects.size(); ++i) {
+        objects[i] = pool.allocate_fast(i);
+    }
+    EXPECT_EQ(channel.try_send_batch(objects.data(), objects.size()), 8);  // Published at once
+
+    std::array<Message*, 5> out{};
+    ASSERT_EQ(channel.try_receive_batch(out.data(), out.size()), 5);
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQ(out[i], objects[i]);
+    }
+    EXPECT_EQ(channel.try_send_batch(objects.data() + 8, 4), 4);  // Space was released
+    ASSERT_EQ(channel.try_receive_batch(out.data(), out.size()), 5);
+    EXPECT_EQ(out[0], objects[5]);
+    EXPECT_EQ(out[4], objects[9]);
+}
+
+TEST_F(SpscHandoffChannelTest, ConcurrentHandoff) {
+    constexpr std::uint64_t num_messages = 100000;
+    LockFreeMemoryPool<Message> pool(256);
+    SpscHandoffChannel<Message> channel(pool, 128, 16);
+    bool out_of_order = false;
+
+    std::thread consumer([&] {
+        std::uint64_t expected = 0;
+        while (expected < num_messages) {
+            if (Message* received = channel.try_receive()) {
+                out_of_order = out_of_order || received->seq != expected;
+                ++expected;
+                pool.deallocate_fast(received);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (std::uint64_t seq = 0; seq < num_messages; ++seq) {
+        Message* message = pool.allocate_fast(seq);
+        while (!message) {
+            channel.flush();  // The consumer frees only what it can see
+            std::this_thread::yield();
+            message = pool.allocate_fast(seq);
+        }
+        while (!channel.try_send(message)) {
+            std::this_thread::yield();
+        }
+    }
+    channel.flush();
+    consumer.join();
+
+    EXPECT_FALSE(out_of_order);
+    // Every object came back to the pool
+    std::vector<Message*> all;
+    while (Message* message = pool.allocate_fast(0)) {
+        all.push_back(message);
+    }
+    EXPECT_EQ(all.size(), pool.capacity());
+    for (Message* message : all) {
+        pool.deallocate_fast(message);
+    }
+}
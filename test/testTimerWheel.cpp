@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "../src/TimerWheel.h"
+
+using namespace lfmemorypool;
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+TEST_F(TimerWheelTest, FiresAtExpiry) {
+    TimerWheel<int> wheel(16);
+    EXPECT_EQ(wheel.capacity(), 16);
+    ASSERT_TRUE(wheel.arm(5, 1).valid());
+    ASSERT_TRUE(wheel.arm(3, 2).valid());
+    ASSERT_TRUE(wheel.arm(0, 3).valid());  // Already due: fires on the next tick
+    EXPECT_EQ(wheel.size(), 3);
+
+    std::vector<int> fired;
+    const auto record = [&fired](int value) { fired.push_back(value); };
+    EXPECT_EQ(wheel.advance(2, record), 1u);
+    EXPECT_EQ(fired, (std::vector<int>{3}));
+    EXPECT_EQ(wheel.advance(4, record), 1u);
+    EXPECT_EQ(wheel.advance(5, record), 1u);
+    EXPECT_EQ(fired, (std::vector<int>{3, 2, 1}));
+    EXPECT_EQ(wheel.size(), 0);
+    EXPECT_EQ(wheel.now(), 5);
+}
+
+TEST_F(TimerWheelTest, CancelAndStaleHandles) {
+    TimerWheel<int> wheel(4);
+    const TimerHandle a = wheel.arm(10, 1);
+    const TimerHandle b = wheel.arm(10, 2);
+    EXPECT_TRUE(wheel.cancel(a));
+    EXPECT_FALSE(wheel.cancel(a));  // Already cancelled
+    EXPECT_FALSE(wheel.cancel(TimerHandle{}));
+
+    // The cancelled timer's slot is reused; the old handle must not cancel the new timer
+    const TimerHandle c = wheel.arm(20, 3);
+    EXPECT_FALSE(wheel.cancel(a));
+
+    std::vector<int> fired;
+    wheel.advance(30, [&fired](int value) { fired.push_back(value); });
+    EXPECT_EQ(fired, (std::vector<int>{2, 3}));
+    EXPECT_FALSE(wheel.cancel(b));  // Already fired
+    EXPECT_FALSE(wheel.cancel(c));
+}
+
+TEST_F(TimerWheelTest, BoundedByCapacity) {
+    TimerWheel<int> wheel(2);
+    EXPECT_TRUE(wheel.arm(1, 0).valid());
+    const TimerHandle second = wheel.arm(2, 0);
+    EXPECT_TRUE(second.valid());
+    EXPECT_FALSE(wheel.arm(3, 0).valid());
+    EXPECT_TRUE(wheel.cancel(second));
+    EXPECT_TRUE(wheel.arm(3, 0).valid());
+}
+
+TEST_F(TimerWheelTest, CascadesAcrossLevels) {
+    // Expiries on every level, including across level boundaries and beyond 2^32 ticks
+    const std::uint64_t start = 1000;
+    const std::vector<std::uint64_t> delays = {
+        1, 255, 256, 257, 65535, 65536, 65537, 1 << 20,
+        16777216, 16777217, 1ULL << 32, (1ULL << 33) + 7};
+    TimerWheel<std::uint64_t> wheel(delays.size(), start);
+    for (const std::uint64_t delay : delays) {
+        ASSERT_TRUE(wheel.arm(start + delay, start + delay).valid());
+    }
+
+    // Fire in bounded steps so every timer is checked against the clock it fired at
+    std::vector<std::uint64_t> fired;
+    while (wheel.size() > 0) {
+        const std::uint64_t target = wheel.now() + 12345677;
+        wheel.advance(target, [&](std::uint64_t expiry) {
+            EXPECT_EQ(expiry, wheel.now());
+            fired.push_back(expiry);
+        });
+    }
+    ASSERT_EQ(fired.size(), delays.size());
+    for (std::size_t i = 0; i < delays.size(); ++i) {
+        EXPECT_EQ(fired[i], start + delays[i]);
+    }
+}
+
+TEST_F(TimerWheelTest, CallbackMayArmAndCancel) {
+    TimerWheel<int> wheel(8);
+    TimerHandle victim = wheel.arm(3, -1);
+    ASSERT_TRUE(wheel.arm(3, 1).valid());
+    std::vector<int> fired;
+    wheel.advance(10, [&](int value) {
+        fired.push_back(value);
+        if (value == 1) {
+            // Re-arming inside the callback, even for a past tick, fires on a later tick
+            static_cast<void>(wheel.arm(0, 2));
+        }
+        if (value == 2) {
+            static_cast<void>(wheel.cancel(victim));
+        }
+    });
+    EXPECT_EQ(fired, (std::vector<int>{-1, 1, 2}));
+
+    // Cancelling a pending timer from a callback on the same tick
+    const TimerHandle first = wheel.arm(20, 1);
+    victim = wheel.arm(20, 2);
+    static_cast<void>(first);
+    fired.clear();
+    wheel.advance(20, [&](int value) {
+        fired.push_back(value);
+        EXPECT_TRUE(wheel.cancel(victim));
+    });
+    EXPECT_EQ(fired, (std::vector<int>{1}));
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+TEST_F(TimerWheelTest, ThrowingCallbackReleasesTimer) {
+    TimerWheel<int> wheel(1);
+    ASSERT_TRUE(wheel.arm(1, 7).valid());
+    EXPECT_THROW(wheel.advance(1, [](int) { throw std::runtime_error("callback"); }),
+                 std::runtime_error);
+    EXPECT_EQ(wheel.size(), 0);
+    EXPECT_TRUE(wheel.arm(5, 8).valid());  // The slot went back to the pool
+}
+
+TEST_F(TimerWheelTest, MatchesOrderedReference) {
+    // Random arms, cancels and advances against a map of the live timers
+    TimerWheel<std::uint32_t> wheel(4096);
+    std::map<std::uint32_t, std::pair<std::uint64_t, TimerHandle>> live;  // id -> expiry, handle
+    std::uint64_t state = 42;
+    const auto next = [&state] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    std::uint32_t next_id = 0;
+    for (int op = 0; op < 50000; ++op) {
+        const std::uint64_t r = next();
+        if (r % 4 != 0 && live.size() < 4096) {
+            const std::uint64_t horizon = r % 3 == 0 ? 100000 : 600;
+            const std::uint64_t expiry = wheel.now() + 1 + (r >> 8) % horizon;
+            const TimerHandle handle = wheel.arm(expiry, next_id);
+            ASSERT_TRUE(handle.valid());
+            live.emplace(next_id++, std::make_pair(expiry, handle));
+        } else if (r % 8 == 4 && !live.empty()) {
+            auto it = live.lower_bound(static_cast<std::uint32_t>((r >> 16) % next_id));
+            if (it == live.end()) {
+                it = live.begin();
+            }
+            EXPECT_TRUE(wheel.cancel(it->second.second));
+            live.erase(it);
+        } else {
+            wheel.advance(wheel.now() + (r >> 40) % 300, [&](std::uint32_t id) {
+                const auto it = live.find(id);
+                ASSERT_NE(it, live.end());
+                EXPECT_EQ(it->second.first, wheel.now());
+                live.erase(it);
+            });
+            for (const auto& [id, timer] : live) {
+                ASSERT_GT(timer.first, wheel.now()) << "timer " << id << " did not fire";
+            }
+        }
+        ASSERT_EQ(wheel.size(), live.size());
+    }
+}
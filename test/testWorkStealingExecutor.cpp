@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "../src/WorkStealingExecutor.h"
+
+using namespace lfmemorypool;
+
+class WorkStealingExecutorTest : public ::testing::Test {
+protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+namespace {
+
+std::uint64_t fib_serial(int n) {
+    return n < 2 ? static_cast<std::uint64_t>(n) : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+// Fork-join fib: the child runs as a task, the parent waits for it while executing others
+std::uint64_t fib_parallel(WorkStealingExecutor& executor, int n) {
+    if (n < 10) {
+        return fib_serial(n);
+    }
+    std::uint64_t left = 0;
+    std::atomic<bool> done{false};
+    executor.spawn([&executor, &left, &done, n] {
+        left = fib_parallel(executor, n - 1);
+        done.store(true, std::memory_order_release);
+    });
+    const std::uint64_t right = fib_parallel(executor, n - 2);
+    executor.wait_until([&done] { return done.load(std::memory_order_acquire); });
+    return left + right;
+}
+
+}  // namespace
+
+TEST_F(WorkStealingExecutorTest, RunsEverySpawnedTask) {
+    WorkStealingExecutor executor(4);
+    EXPECT_EQ(executor.thread_count(), 4);
+
+    std::atomic<int> sum{0};
+    for (int i = 1; i <= 1000; ++i) {
+        executor.spawn([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); });
+    }
+    executor.wait_idle();
+    EXPECT_EQ(sum.load(), 1000 * 1001 / 2);
+}
+
+TEST_F(WorkStealingExecutorTest, NestedSpawns) {
+    WorkStealingExecutor executor(4);
+    std::atomic<int> leaves{0};
+    for (int i = 0; i < 16; ++i) {
+        executor.spawn([&executor, &leaves] {
+            for (int j = 0; j < 64; ++j) {
+                executor.spawn([&leaves] { leaves.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    executor.wait_idle();
+    EXPECT_EQ(leaves.load(), 16 * 64);
+}
+
+TEST_F(WorkStealingExecutorTest, ForkJoinFib) {
+    WorkStealingExecutor executor(4);
+    EXPECT_EQ(fib_parallel(executor, 25), fib_serial(25));
+
+    // The same from inside a task
+    std::uint64_t result = 0;
+    std::atomic<bool> done{false};
+    executor.spawn([&] {
+        result = fib_parallel(executor, 22);
+        done = true;
+    });
+    executor.wait_until([&done] { return done.load(); });
+    EXPECT_EQ(result, fib_serial(22));
+}
+
+TEST_F(WorkStealingExecutorTest, FullQueuesRunInline) {
+    // Two task slots and a two-entry deque: most spawns find no room and run in the caller
+    WorkStealingExecutor executor(2, 2, 2);
+    std::atomic<int> count{0};
+    executor.spawn([&executor, &count] {
+        for (int i = 0; i < 1000; ++i) {
+            executor.spawn([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        executor.spawn([&count] { count.fetch_add(1, std::memory_order_relaxed); });
+    }
+    executor.wait_idle();
+    EXPECT_EQ(count.load(), 2000);
+}
+
+TEST_F(WorkStealingExecutorTest, CallablesAreDestroyed) {
+    struct Counted {
+        explicit Counted(std::atomic<int>& live) : live(&live) {
+            live.fetch_add(1);
+        }
+        Counted(const Counted& other) : live(other.live) {
+            live->fetch_add(1);
+        }
+        ~Counted() {
+            live->fetch_sub(1);
+        }
+        std::atomic<int>* live;
+    };
+
+    std::atomic<int> live{0};
+    std::atomic<int> ran{0};
+    {
+        WorkStealingExecutor executor(2);
+        for (int i = 0; i < 100; ++i) {
+            Counted counted(live);
+            executor.spawn([counted, &ran] { ran.fetch_add(1); });
+        }
+        // The destructor finishes the outstanding tasks
+    }
+    EXPECT_EQ(ran.load(), 100);
+    EXPECT_EQ(live.load(), 0);
+}
+
+TEST_F(WorkStealingExecutorTest, ManyExternalSpawners) {
+    WorkStealingExecutor executor(2);
+    std::array<std::atomic<int>, 4> counts{};
+    std::vector<std::thread> spawners;
+    for (int t = 0; t < 4; ++t) {
+        spawners.emplace_back([&executor, &counts, t] {
+            for (int i = 0; i < 5000; ++i) {
+                executor.spawn([&counts, t] { counts[t].fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (auto& spawner : spawners) {
+        spawner.join();
+    }
+    executor.wait_idle();
+    for (const auto& count : counts) {
+        EXPECT_EQ(count.load(), 5000);
+    }
+}